@@ -0,0 +1,36 @@
+#include "Baseline.h"
+
+BaselineVec2 BaselineStep(BaselineVec2 position, BaselineVec2 velocity, float deltaTime)
+{
+   BaselineVec2 result;
+   result.x = position.x + velocity.x * deltaTime;
+   result.y = position.y + velocity.y * deltaTime;
+   return result;
+}
+float BaselineProject(BaselineVec2 position, BaselineVec2 axis)
+{
+   return position.x * axis.x + position.y * axis.y;
+}
+
+i32 BaselineAccumulate(BaselineSlotI32* slot, i32 amount)
+{
+   slot->value += amount;
+   slot->writes += 1;
+   return slot->writes;
+}
+float BaselineBlend(BaselineSlotFloat* slot, float amount)
+{
+   slot->value = slot->value * 0.5f + amount;
+   slot->writes += 1;
+   return slot->value;
+}
+
+BaselineParticle BaselineSpawn(float x, float y)
+{
+   BaselineParticle result;
+   result.x = x;
+   result.y = y;
+   result.speed = 1.0f;
+   result.age = 0;
+   return result;
+}
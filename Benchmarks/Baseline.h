@@ -0,0 +1,112 @@
+#pragma once
+
+//hand-written C equivalents of the Linxc benchmarks, which the generated code is timed against.
+//Each is written the way one would write it in C directly, keeping the same allocation strategy
+
+#include <Linxc.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+typedef struct BaselineVec2 {
+   float x;
+   float y;
+} BaselineVec2;
+BaselineVec2 BaselineStep(BaselineVec2 position, BaselineVec2 velocity, float deltaTime);
+float BaselineProject(BaselineVec2 position, BaselineVec2 axis);
+
+typedef struct BaselineSlotI32 {
+   i32 value;
+   i32 writes;
+} BaselineSlotI32;
+typedef struct BaselineSlotFloat {
+   float value;
+   i32 writes;
+} BaselineSlotFloat;
+i32 BaselineAccumulate(BaselineSlotI32* slot, i32 amount);
+float BaselineBlend(BaselineSlotFloat* slot, float amount);
+
+typedef struct BaselineParticle {
+   float x;
+   float y;
+   float speed;
+   i32 age;
+} BaselineParticle;
+BaselineParticle BaselineSpawn(float x, float y);
+
+typedef struct BaselineParticles {
+   usize count;
+   usize capacity;
+   float* x;
+   float* y;
+   float* speed;
+   i32* age;
+} BaselineParticles;
+static inline bool BaselineParticles_Reserve(BaselineParticles* particles, usize minCapacity)
+{
+   if (minCapacity <= particles->capacity)
+   {
+      return true;
+   }
+   usize newCapacity = particles->capacity == 0 ? 8 : particles->capacity * 2;
+   while (newCapacity < minCapacity)
+   {
+      newCapacity *= 2;
+   }
+   float* x = (float*)malloc(sizeof(float) * newCapacity);
+   float* y = (float*)malloc(sizeof(float) * newCapacity);
+   float* speed = (float*)malloc(sizeof(float) * newCapacity);
+   i32* age = (i32*)malloc(sizeof(i32) * newCapacity);
+   if (x == NULL || y == NULL || speed == NULL || age == NULL)
+   {
+      if (x != NULL) free(x);
+      if (y != NULL) free(y);
+      if (speed != NULL) free(speed);
+      if (age != NULL) free(age);
+      return false;
+   }
+   for (usize i = 0; i < particles->count; i++)
+   {
+      x[i] = particles->x[i];
+      y[i] = particles->y[i];
+      speed[i] = particles->speed[i];
+      age[i] = particles->age[i];
+   }
+   if (particles->capacity > 0)
+   {
+      free(particles->x);
+      free(particles->y);
+      free(particles->speed);
+      free(particles->age);
+   }
+   particles->x = x;
+   particles->y = y;
+   particles->speed = speed;
+   particles->age = age;
+   particles->capacity = newCapacity;
+   return true;
+}
+static inline bool BaselineParticles_Add(BaselineParticles* particles, BaselineParticle value)
+{
+   if (!BaselineParticles_Reserve(particles, particles->count + 1))
+   {
+      return false;
+   }
+   particles->x[particles->count] = value.x;
+   particles->y[particles->count] = value.y;
+   particles->speed[particles->count] = value.speed;
+   particles->age[particles->count] = value.age;
+   particles->count += 1;
+   return true;
+}
+static inline void BaselineParticles_Deinit(BaselineParticles* particles)
+{
+   if (particles->capacity > 0)
+   {
+      free(particles->x);
+      free(particles->y);
+      free(particles->speed);
+      free(particles->age);
+   }
+   particles->count = 0;
+   particles->capacity = 0;
+}
@@ -0,0 +1,111 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <parser.hpp>
+#include <ArenaAllocator.hpp>
+
+#if WINDOWS
+#include <direct.h>
+#endif
+#if POSIX
+#include <sys/stat.h>
+#endif
+
+//Transpiles the benchmark suite, compiles the output along with Baseline.c and Harness.c using the C compiler named by
+//the CC environment variable (cc if unset) at -O2, then runs the harness, which times each benchmark against its hand-written equivalent.
+//Usage: LinxccBench [benchmarks directory] [tolerance], where tolerance is the slowdown relative to hand-written C at which the run fails.
+//Returns nonzero if anything fails to transpile, compile, computes the wrong result or is slower than tolerance.
+
+const char *benchmarkNames[] = { "Vectors", "Containers", "Particles" };
+#define BENCHMARK_COUNT (sizeof(benchmarkNames) / sizeof(benchmarkNames[0]))
+
+i32 main(i32 argc, char **argv)
+{
+    const char *benchmarksDirectory = argc > 1 ? argv[1] : "Benchmarks";
+    const char *tolerance = argc > 2 ? argv[2] : "0";
+    const char *compiler = getenv("CC") != NULL ? getenv("CC") : "cc";
+
+    char outputDirectory[1024];
+    snprintf(outputDirectory, sizeof(outputDirectory), "%s/linxc-out", benchmarksDirectory);
+    #if WINDOWS
+    _mkdir(outputDirectory);
+    #endif
+    #if POSIX
+    mkdir(outputDirectory, 0755);
+    #endif
+
+    ArenaAllocator arena = ArenaAllocator(&defaultAllocator);
+    LinxcParser parser = LinxcParser(&arena.asAllocator);
+    parser.reportLayouts = true;
+    LinxcParsedFile *parsedFiles[BENCHMARK_COUNT];
+    //the parser refers to these until it is done transpiling
+    string fileFullNames[BENCHMARK_COUNT];
+    string fileIncludeNames[BENCHMARK_COUNT];
+    string fileContents[BENCHMARK_COUNT];
+    bool success = true;
+
+    for (usize i = 0; i < BENCHMARK_COUNT; i++)
+    {
+        char path[1024];
+        snprintf(path, sizeof(path), "%s/%s.linxc", benchmarksDirectory, benchmarkNames[i]);
+        fileFullNames[i] = string(path);
+        snprintf(path, sizeof(path), "%s.linxc", benchmarkNames[i]);
+        fileIncludeNames[i] = string(path);
+        fileContents[i] = io::ReadFile(fileFullNames[i].buffer);
+
+        parsedFiles[i] = parser.ParseFile(fileFullNames[i], fileIncludeNames[i], fileContents[i]);
+        for (usize j = 0; j < parsedFiles[i]->errors.count; j++)
+        {
+            printf("Error in %s: %s\n", fileIncludeNames[i].buffer, parsedFiles[i]->errors.Get(j)->buffer);
+            success = false;
+        }
+    }
+
+    if (success)
+    {
+        char sourcePath[1024];
+        char headerPath[1024];
+        for (usize i = 0; i < BENCHMARK_COUNT; i++)
+        {
+            snprintf(sourcePath, sizeof(sourcePath), "%s/%s.c", outputDirectory, benchmarkNames[i]);
+            snprintf(headerPath, sizeof(headerPath), "%s/%s.h", outputDirectory, benchmarkNames[i]);
+            parser.TranspileFile(parsedFiles[i], sourcePath, headerPath);
+        }
+        snprintf(sourcePath, sizeof(sourcePath), "%s/Instantiations.c", outputDirectory);
+        parser.TranspileInstantiations(parsedFiles, BENCHMARK_COUNT, sourcePath);
+        //written alongside the output, so that padding in the benchmarked structs shows up next to their timings
+        snprintf(sourcePath, sizeof(sourcePath), "%s/Layouts.txt", outputDirectory);
+        parser.layoutReport.WriteToFile(sourcePath);
+
+        char command[8192];
+        i32 length = snprintf(command, sizeof(command), "%s -std=c11 -O2 -I%s -I%s -I%s/../src/linxcstd -o %s/Harness", compiler, outputDirectory, benchmarksDirectory, benchmarksDirectory, outputDirectory);
+        for (usize i = 0; i < BENCHMARK_COUNT; i++)
+        {
+            length += snprintf(command + length, sizeof(command) - length, " %s/%s.c", outputDirectory, benchmarkNames[i]);
+        }
+        snprintf(command + length, sizeof(command) - length, " %s/Instantiations.c %s/Baseline.c %s/Harness.c -lm", outputDirectory, benchmarksDirectory, benchmarksDirectory);
+
+        printf("%s\n", command);
+        fflush(stdout);
+        if (system(command) != 0)
+        {
+            printf("Failed to compile the transpiled benchmarks\n");
+            success = false;
+        }
+        else
+        {
+            snprintf(command, sizeof(command), "%s/Harness %s", outputDirectory, tolerance);
+            success = system(command) == 0;
+        }
+    }
+
+    for (usize i = 0; i < BENCHMARK_COUNT; i++)
+    {
+        fileFullNames[i].deinit();
+        fileIncludeNames[i].deinit();
+        fileContents[i].deinit();
+    }
+    parser.deinit();
+    arena.deinit();
+
+    return success ? 0 : 1;
+}
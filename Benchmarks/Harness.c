@@ -0,0 +1,194 @@
+//times the transpiled benchmarks against their hand-written equivalents in Baseline.c.
+//Usage: Harness [tolerance], where a benchmark running more than tolerance times slower than its baseline fails the run
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include <Vectors.h>
+#include <Containers.h>
+#include <Particles.h>
+#include "Baseline.h"
+
+#define BENCH_REPEATS 7
+#define BENCH_PARTICLES_PER_ROUND 1024
+
+//runs a benchmark for the given number of iterations, returning a checksum of its results
+typedef double (*BenchFunc)(usize iterations);
+
+typedef struct Benchmark {
+   const char* name;
+   usize iterations;
+   BenchFunc generated;
+   BenchFunc baseline;
+} Benchmark;
+
+static double StepGenerated(usize iterations)
+{
+   Vectors_Vec2 position = { 0.0f, 0.0f };
+   Vectors_Vec2 velocity = { 1.0f, 2.0f };
+   for (usize i = 0; i < iterations; i++)
+   {
+      position = Step(position, velocity, 0.001f);
+   }
+   return position.x + position.y;
+}
+static double StepBaseline(usize iterations)
+{
+   BaselineVec2 position = { 0.0f, 0.0f };
+   BaselineVec2 velocity = { 1.0f, 2.0f };
+   for (usize i = 0; i < iterations; i++)
+   {
+      position = BaselineStep(position, velocity, 0.001f);
+   }
+   return position.x + position.y;
+}
+
+static double ProjectGenerated(usize iterations)
+{
+   Vectors_Vec2 position = { 0.0f, 1.0f };
+   Vectors_Vec2 axis = { 0.6f, 0.8f };
+   double total = 0.0;
+   for (usize i = 0; i < iterations; i++)
+   {
+      position.x = (float)(i & 1023);
+      total += Project(position, axis);
+   }
+   return total;
+}
+static double ProjectBaseline(usize iterations)
+{
+   BaselineVec2 position = { 0.0f, 1.0f };
+   BaselineVec2 axis = { 0.6f, 0.8f };
+   double total = 0.0;
+   for (usize i = 0; i < iterations; i++)
+   {
+      position.x = (float)(i & 1023);
+      total += BaselineProject(position, axis);
+   }
+   return total;
+}
+
+static double SlotGenerated(usize iterations)
+{
+   Containers_Slot_i32 counter = { 0, 0 };
+   Containers_Slot_float blend = { 0.0f, 0 };
+   double total = 0.0;
+   for (usize i = 0; i < iterations; i++)
+   {
+      total += Accumulate(&counter, (i32)(i & 255));
+      total += Blend(&blend, 1.0f);
+   }
+   return total + counter.value;
+}
+static double SlotBaseline(usize iterations)
+{
+   BaselineSlotI32 counter = { 0, 0 };
+   BaselineSlotFloat blend = { 0.0f, 0 };
+   double total = 0.0;
+   for (usize i = 0; i < iterations; i++)
+   {
+      total += BaselineAccumulate(&counter, (i32)(i & 255));
+      total += BaselineBlend(&blend, 1.0f);
+   }
+   return total + counter.value;
+}
+
+//fills a fresh container every round, so that growing it is timed along with reading it back
+static double ParticlesGenerated(usize iterations)
+{
+   double total = 0.0;
+   for (usize round = 0; round < iterations / BENCH_PARTICLES_PER_ROUND; round++)
+   {
+      Particles_ParticleSoA particles = Particles_ParticleSoA_Init(NULL, NULL, NULL);
+      for (usize i = 0; i < BENCH_PARTICLES_PER_ROUND; i++)
+      {
+         Particles_ParticleSoA_Add(&particles, Spawn((float)i, (float)round));
+      }
+      for (usize i = 0; i < particles.linxcCount; i++)
+      {
+         total += particles.x[i] * particles.speed[i] + particles.y[i];
+      }
+      Particles_ParticleSoA_Deinit(&particles);
+   }
+   return total;
+}
+static double ParticlesBaseline(usize iterations)
+{
+   double total = 0.0;
+   for (usize round = 0; round < iterations / BENCH_PARTICLES_PER_ROUND; round++)
+   {
+      BaselineParticles particles = { 0, 0, NULL, NULL, NULL, NULL };
+      for (usize i = 0; i < BENCH_PARTICLES_PER_ROUND; i++)
+      {
+         BaselineParticles_Add(&particles, BaselineSpawn((float)i, (float)round));
+      }
+      for (usize i = 0; i < particles.count; i++)
+      {
+         total += particles.x[i] * particles.speed[i] + particles.y[i];
+      }
+      BaselineParticles_Deinit(&particles);
+   }
+   return total;
+}
+
+static double NowSeconds(void)
+{
+   struct timespec now;
+   timespec_get(&now, TIME_UTC);
+   return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+}
+//returns the fastest of BENCH_REPEATS runs in nanoseconds per iteration, which is the least disturbed by the rest of the system
+static double BenchTime(BenchFunc func, usize iterations, double* checksum)
+{
+   double best = 0.0;
+   for (i32 i = 0; i < BENCH_REPEATS; i++)
+   {
+      double start = NowSeconds();
+      *checksum = func(iterations);
+      double elapsed = (NowSeconds() - start) * 1e9 / (double)iterations;
+      if (i == 0 || elapsed < best)
+      {
+         best = elapsed;
+      }
+   }
+   return best;
+}
+
+int main(int argc, char** argv)
+{
+   Benchmark benchmarks[] = {
+      { "vector step", 20000000, &StepGenerated, &StepBaseline },
+      { "vector project", 20000000, &ProjectGenerated, &ProjectBaseline },
+      { "template slot", 20000000, &SlotGenerated, &SlotBaseline },
+      { "soa particles", 4194304, &ParticlesGenerated, &ParticlesBaseline }
+   };
+   double tolerance = argc > 1 ? atof(argv[1]) : 0.0;
+   int failed = 0;
+
+   printf("%-16s %14s %14s %8s\n", "benchmark", "linxc ns/iter", "C ns/iter", "ratio");
+   for (usize i = 0; i < sizeof(benchmarks) / sizeof(benchmarks[0]); i++)
+   {
+      Benchmark* benchmark = &benchmarks[i];
+      double generatedChecksum;
+      double baselineChecksum;
+      double generated = BenchTime(benchmark->generated, benchmark->iterations, &generatedChecksum);
+      double baseline = BenchTime(benchmark->baseline, benchmark->iterations, &baselineChecksum);
+      double ratio = generated / baseline;
+      printf("%-16s %14.3f %14.3f %7.2fx", benchmark->name, generated, baseline, ratio);
+
+      //a generated benchmark computing something different is a miscompile, and its timing means nothing
+      if (fabs(generatedChecksum - baselineChecksum) > fabs(baselineChecksum) * 1e-9)
+      {
+         printf("  MISMATCH (%f, expected %f)", generatedChecksum, baselineChecksum);
+         failed = 1;
+      }
+      else if (tolerance > 0.0 && ratio > tolerance)
+      {
+         printf("  SLOWER than %.2fx", tolerance);
+         failed = 1;
+      }
+      printf("\n");
+   }
+   return failed;
+}
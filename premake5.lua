@@ -10,10 +10,12 @@ filter "platforms:Windows"
 filter "platforms:MacOS"
     defines { "MACOS", "POSIX" }
     system "macosx"
+    links { "pthread" }
 
 filter "platforms:Linux"
     defines { "LINUX", "POSIX" }
     system "linux"
+    links { "pthread" }
 
 project "Linxcc"
     kind "ConsoleApp"
@@ -32,6 +34,25 @@ project "Linxcc"
         defines { "NDEBUG" }
         optimize "On"
 
+project "LinxccBench"
+    kind "ConsoleApp"
+    language "C++"
+    targetdir "bin/linxccbench/%{cfg.buildcfg}"
+    debugdir "."
+    includedirs {"src/include", "src/linxcstd"}
+    location "Benchmarks"
+
+    files { "src/**.h", "src/**.c", "src/**.hpp", "src/**.cpp", "src/**.linxc", "Benchmarks/Bench.cpp" }
+    removefiles { "src/program.cpp" }
+
+    filter "configurations:Debug"
+        defines { "DEBUG" }
+        symbols "On"
+
+    filter "configurations:Release"
+        defines { "NDEBUG" }
+        optimize "On"
+
 -- project "Test"
 --     kind "ConsoleApp"
 --     language "C++"
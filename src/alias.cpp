@@ -0,0 +1,590 @@
+#include <alias.hpp>
+#include <hashmap.linxc>
+#include <hashset.linxc>
+#include <vector.linxc>
+
+struct LinxcAliasFuncInfo
+{
+    bool called;
+    bool addressTaken;
+};
+/// A call to a function from within the body of caller (or from a global initializer, in which case caller is NULL).
+/// thisExpr is the object a method is called on, or NULL if it is called on the caller's own this.
+struct LinxcAliasCall
+{
+    LinxcFunc *caller;
+    LinxcExpression *call;
+    LinxcExpression *thisExpr;
+    bool thisIsPointer;
+};
+enum LinxcAliasBaseKind
+{
+    LinxcAliasBase_Unknown,
+    LinxcAliasBase_Address,
+    LinxcAliasBase_Param
+};
+/// What a pointer argument is known to point into.
+/// Only the address of a local or parameter of the caller whose address does not escape counts as LinxcAliasBase_Address,
+/// as the callee may reach globals, and anything they point to, without going through its parameters.
+struct LinxcAliasBase
+{
+    LinxcAliasBaseKind kind;
+    LinxcVar *variable;
+};
+
+static i64 LinxcParamIndex(LinxcFunc *func, LinxcVar *var)
+{
+    if (func == NULL || var < func->arguments.data || var >= func->arguments.data + func->arguments.length)
+    {
+        return -1;
+    }
+    return var - func->arguments.data;
+}
+static bool LinxcIsPointerVar(LinxcVar *var)
+{
+    option<LinxcTypeReference> typeRef = var->type.AsTypeReference();
+    return typeRef.present && typeRef.value.pointerCount > 0;
+}
+
+//Marks every parameter of func used by expr in a way other than being dereferenced as not restrict, and records it in kept,
+//as func may store it. Also records every call made by expr and every function whose address is taken
+static void LinxcAliasWalkExpr(LinxcExpression *expr, LinxcFunc *func, collections::vector<LinxcAliasCall> *calls, collections::hashmap<LinxcFunc*, LinxcAliasFuncInfo, collections::PointerKeys> *infos, collections::hashset<LinxcVar*, collections::PointerKeys> *kept)
+{
+    switch (expr->ID)
+    {
+    case LinxcExpr_Variable:
+    {
+        i64 index = LinxcParamIndex(func, expr->data.variable);
+        if (index >= 0)
+        {
+            kept->Add(expr->data.variable);
+        }
+        if (index >= 0 && !(func->arguments.data[index].attributes & LinxcAttribute_NoAlias) && !(func->attributes & LinxcAttribute_NoAlias))
+        {
+            func->arguments.data[index].isRestrict = false;
+        }
+    }
+    break;
+    case LinxcExpr_IncrementVar:
+    case LinxcExpr_DecrementVar:
+    {
+        //pointer arithmetic on a parameter makes it point somewhere else, which we don't track
+        LinxcExpression variable = LinxcExpression();
+        variable.ID = LinxcExpr_Variable;
+        variable.data.variable = expr->ID == LinxcExpr_IncrementVar ? expr->data.incrementVariable : expr->data.decrementVariable;
+        LinxcAliasWalkExpr(&variable, func, calls, infos, kept);
+    }
+    break;
+    case LinxcExpr_Modified:
+    {
+        LinxcModifiedExpression *modified = expr->data.modifiedExpression;
+        if (modified->modification == Linxc_Asterisk && modified->expression.ID == LinxcExpr_Variable)
+        {
+            break;
+        }
+        LinxcAliasWalkExpr(&modified->expression, func, calls, infos, kept);
+    }
+    break;
+    case LinxcExpr_TypeCast:
+        LinxcAliasWalkExpr(&expr->data.typeCast->expressionToCast, func, calls, infos, kept);
+        break;
+    case LinxcExpr_FunctionRef:
+    {
+        LinxcAliasFuncInfo *info = infos->Get(expr->data.functionRef);
+        if (info != NULL)
+        {
+            info->addressTaken = true;
+        }
+    }
+    break;
+    case LinxcExpr_FuncCall:
+    {
+        LinxcAliasCall call;
+        call.caller = func;
+        call.call = expr;
+        call.thisExpr = NULL;
+        call.thisIsPointer = false;
+        calls->Add(call);
+        for (usize i = 0; i < expr->data.functionCall.inputParams.length; i++)
+        {
+            //passing a parameter straight on to a restrict parameter keeps it restrict, which LinxcAliasCheckCall decides
+            LinxcExpression *input = &expr->data.functionCall.inputParams.data[i];
+            if (input->ID == LinxcExpr_Variable && LinxcParamIndex(func, input->data.variable) >= 0)
+            {
+                continue;
+            }
+            LinxcAliasWalkExpr(input, func, calls, infos, kept);
+        }
+    }
+    break;
+    case LinxcExpr_OperatorCall:
+    {
+        LinxcOperator *op = expr->data.operatorCall;
+        if (op->operatorType == Linxc_ColonColon)
+        {
+            LinxcAliasWalkExpr(&op->rightExpr, func, calls, infos, kept);
+        }
+        else if (op->operatorType == Linxc_Arrow || op->operatorType == Linxc_Period)
+        {
+            if (op->rightExpr.ID == LinxcExpr_FuncCall)
+            {
+                //a method call passes the left side on as this
+                LinxcAliasWalkExpr(&op->leftExpr, func, calls, infos, kept);
+                usize callIndex = calls->count;
+                LinxcAliasWalkExpr(&op->rightExpr, func, calls, infos, kept);
+                calls->Get(callIndex)->thisExpr = &op->leftExpr;
+                calls->Get(callIndex)->thisIsPointer = op->operatorType == Linxc_Arrow;
+            }
+            //p->member only dereferences p
+            else if (!(op->operatorType == Linxc_Arrow && op->leftExpr.ID == LinxcExpr_Variable))
+            {
+                LinxcAliasWalkExpr(&op->leftExpr, func, calls, infos, kept);
+            }
+        }
+        else
+        {
+            LinxcAliasWalkExpr(&op->leftExpr, func, calls, infos, kept);
+            LinxcAliasWalkExpr(&op->rightExpr, func, calls, infos, kept);
+        }
+    }
+    break;
+    default:
+        break;
+    }
+}
+static void LinxcAliasWalkBody(collections::vector<LinxcStatement> *body, LinxcFunc *func, collections::vector<LinxcAliasCall> *calls, collections::hashmap<LinxcFunc*, LinxcAliasFuncInfo, collections::PointerKeys> *infos, collections::hashset<LinxcVar*, collections::PointerKeys> *kept)
+{
+    for (usize i = 0; i < body->count; i++)
+    {
+        LinxcStatement *stmt = body->Get(i);
+        if (stmt->ID == LinxcStmt_Expr)
+        {
+            LinxcAliasWalkExpr(&stmt->data.expression, func, calls, infos, kept);
+        }
+        else if (stmt->ID == LinxcStmt_Return)
+        {
+            LinxcAliasWalkExpr(&stmt->data.returnStatement, func, calls, infos, kept);
+        }
+        else if (stmt->ID == LinxcStmt_VarDecl && stmt->data.varDeclaration->defaultValue.present)
+        {
+            LinxcAliasWalkExpr(&stmt->data.varDeclaration->defaultValue.value, func, calls, infos, kept);
+        }
+    }
+}
+
+static void LinxcAliasCollectFunc(LinxcFunc *func, collections::vector<LinxcFunc*> *funcs, collections::hashmap<LinxcFunc*, LinxcAliasFuncInfo, collections::PointerKeys> *infos)
+{
+    LinxcAliasFuncInfo info;
+    info.called = false;
+    info.addressTaken = false;
+    funcs->Add(func);
+    infos->Add(func, info);
+    //start from the optimistic assumption and let the walks below disprove it
+    for (usize i = 0; i < func->arguments.length; i++)
+    {
+        func->arguments.data[i].isRestrict = LinxcIsPointerVar(&func->arguments.data[i]);
+    }
+}
+static void LinxcAliasCollectType(LinxcType *type, collections::vector<LinxcFunc*> *funcs, collections::hashmap<LinxcFunc*, LinxcAliasFuncInfo, collections::PointerKeys> *infos)
+{
+    for (usize i = 0; i < type->functions.count; i++)
+    {
+        LinxcAliasCollectFunc(type->functions.Get(i), funcs, infos);
+    }
+    //operator overloads are never called by a LinxcExpr_FuncCall, so their own parameters are never inferred restrict,
+    //but the calls they make are still needed to judge their callees
+    for (usize i = 0; i < type->operatorOverloads.entries.count; i++)
+    {
+        LinxcAliasCollectFunc(&type->operatorOverloads.entries.ptr[i].func->function, funcs, infos);
+    }
+    for (usize i = 0; i < type->subTypes.count; i++)
+    {
+        LinxcAliasCollectType(type->subTypes.Get(i), funcs, infos);
+    }
+}
+static void LinxcAliasCollect(LinxcNamespace *nameSpace, collections::vector<LinxcFunc*> *funcs, collections::vector<LinxcVar*> *globals, collections::hashmap<LinxcFunc*, LinxcAliasFuncInfo, collections::PointerKeys> *infos)
+{
+    LinxcSymbolTable *symbols = &nameSpace->symbols;
+    for (u32 i = 0; i < symbols->capacity; i++)
+    {
+        LinxcSymbol *symbol = &symbols->slots[i];
+        switch (symbol->kind)
+        {
+        case LinxcSymbol_Func:
+            LinxcAliasCollectFunc(symbol->data.function, funcs, infos);
+            break;
+        case LinxcSymbol_Var:
+            globals->Add(symbol->data.variable);
+            break;
+        case LinxcSymbol_Type:
+            LinxcAliasCollectType(symbol->data.type, funcs, infos);
+            break;
+        case LinxcSymbol_Namespace:
+            LinxcAliasCollect(symbol->data.namespaceRef, funcs, globals, infos);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+static bool LinxcIsLocalOf(LinxcFunc *func, LinxcVar *var)
+{
+    if (func == NULL)
+    {
+        return false;
+    }
+    if (LinxcParamIndex(func, var) >= 0)
+    {
+        return true;
+    }
+    for (usize i = 0; i < func->body.count; i++)
+    {
+        LinxcStatement *stmt = func->body.Get(i);
+        if (stmt->ID == LinxcStmt_VarDecl && stmt->data.varDeclaration == var)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+//Returns the variable addressOf takes the address of, or of a member of, if it is a local or parameter of func. NULL otherwise
+static LinxcVar *LinxcAddressedLocal(LinxcExpression *addressOf, LinxcFunc *func)
+{
+    //&s.member lies within s
+    while (addressOf->ID == LinxcExpr_OperatorCall && addressOf->data.operatorCall->operatorType == Linxc_Period)
+    {
+        addressOf = &addressOf->data.operatorCall->leftExpr;
+    }
+    if (addressOf->ID == LinxcExpr_Variable && LinxcIsLocalOf(func, addressOf->data.variable))
+    {
+        return addressOf->data.variable;
+    }
+    return NULL;
+}
+static LinxcExpression *LinxcUncast(LinxcExpression *expr)
+{
+    while (expr->ID == LinxcExpr_TypeCast)
+    {
+        expr = &expr->data.typeCast->expressionToCast;
+    }
+    return expr;
+}
+static LinxcAliasBase LinxcBaseOf(LinxcExpression *expr, bool isPointer, LinxcFunc *caller, collections::hashset<LinxcVar*, collections::PointerKeys> *escaped)
+{
+    LinxcAliasBase result;
+    result.kind = LinxcAliasBase_Unknown;
+    result.variable = NULL;
+
+    expr = LinxcUncast(expr);
+    LinxcExpression *addressOf = NULL;
+    if (!isPointer)
+    {
+        //a struct value that a method is called on, passed as &value
+        addressOf = expr;
+    }
+    else if (expr->ID == LinxcExpr_Modified && expr->data.modifiedExpression->modification == Linxc_Ampersand)
+    {
+        addressOf = &expr->data.modifiedExpression->expression;
+    }
+
+    if (addressOf != NULL)
+    {
+        LinxcVar *local = LinxcAddressedLocal(addressOf, caller);
+        if (local != NULL && !escaped->Contains(local))
+        {
+            result.kind = LinxcAliasBase_Address;
+            result.variable = local;
+        }
+    }
+    else if (expr->ID == LinxcExpr_Variable && LinxcParamIndex(caller, expr->data.variable) >= 0 && expr->data.variable->isRestrict)
+    {
+        result.kind = LinxcAliasBase_Param;
+        result.variable = expr->data.variable;
+    }
+    return result;
+}
+//Records every local of func whose address expr takes other than to pass it straight to a call, which LinxcAliasCheckCall judges,
+//as the pointer may be stored anywhere, including somewhere a callee can reach
+static void LinxcAliasWalkEscapes(LinxcExpression *expr, LinxcFunc *func, collections::hashset<LinxcVar*, collections::PointerKeys> *escaped)
+{
+    switch (expr->ID)
+    {
+    case LinxcExpr_Modified:
+    {
+        LinxcModifiedExpression *modified = expr->data.modifiedExpression;
+        if (modified->modification == Linxc_Ampersand)
+        {
+            LinxcVar *local = LinxcAddressedLocal(&modified->expression, func);
+            if (local != NULL)
+            {
+                escaped->Add(local);
+            }
+        }
+        LinxcAliasWalkEscapes(&modified->expression, func, escaped);
+    }
+    break;
+    case LinxcExpr_TypeCast:
+        LinxcAliasWalkEscapes(&expr->data.typeCast->expressionToCast, func, escaped);
+        break;
+    case LinxcExpr_Indexer:
+        LinxcAliasWalkEscapes(expr->data.indexerCall, func, escaped);
+        break;
+    case LinxcExpr_FuncCall:
+    {
+        for (usize i = 0; i < expr->data.functionCall.inputParams.length; i++)
+        {
+            LinxcExpression *input = LinxcUncast(&expr->data.functionCall.inputParams.data[i]);
+            if (input->ID == LinxcExpr_Modified && input->data.modifiedExpression->modification == Linxc_Ampersand)
+            {
+                input = &input->data.modifiedExpression->expression;
+            }
+            LinxcAliasWalkEscapes(input, func, escaped);
+        }
+    }
+    break;
+    case LinxcExpr_OperatorCall:
+    {
+        LinxcOperator *op = expr->data.operatorCall;
+        //a method called on a struct value is passed its address as this, which is never restrict
+        if (op->operatorType == Linxc_Period && op->rightExpr.ID == LinxcExpr_FuncCall)
+        {
+            LinxcVar *local = LinxcAddressedLocal(&op->leftExpr, func);
+            if (local != NULL)
+            {
+                escaped->Add(local);
+            }
+        }
+        if (op->operatorType != Linxc_ColonColon)
+        {
+            LinxcAliasWalkEscapes(&op->leftExpr, func, escaped);
+        }
+        LinxcAliasWalkEscapes(&op->rightExpr, func, escaped);
+    }
+    break;
+    default:
+        break;
+    }
+}
+static void LinxcAliasWalkBodyEscapes(collections::vector<LinxcStatement> *body, LinxcFunc *func, collections::hashset<LinxcVar*, collections::PointerKeys> *escaped)
+{
+    for (usize i = 0; i < body->count; i++)
+    {
+        LinxcStatement *stmt = body->Get(i);
+        if (stmt->ID == LinxcStmt_Expr)
+        {
+            LinxcAliasWalkEscapes(&stmt->data.expression, func, escaped);
+        }
+        else if (stmt->ID == LinxcStmt_Return)
+        {
+            LinxcAliasWalkEscapes(&stmt->data.returnStatement, func, escaped);
+        }
+        else if (stmt->ID == LinxcStmt_VarDecl && stmt->data.varDeclaration->defaultValue.present)
+        {
+            LinxcAliasWalkEscapes(&stmt->data.varDeclaration->defaultValue.value, func, escaped);
+        }
+    }
+}
+static bool LinxcBasesDistinct(LinxcAliasBase A, LinxcAliasBase B)
+{
+    if (A.kind == LinxcAliasBase_Unknown || B.kind == LinxcAliasBase_Unknown || A.variable == B.variable)
+    {
+        return false;
+    }
+    //a restrict parameter never points at the caller's own locals
+    return true;
+}
+
+//Clears isRestrict on every parameter of the called function that this call may pass an aliasing pointer to.
+//Records the parameters and locals of the caller that this call passes on to a parameter in kept, in kept and escaped respectively.
+//Returns whether anything changed
+static bool LinxcAliasCheckCall(LinxcAliasCall *call, collections::hashset<LinxcVar*, collections::PointerKeys> *kept, collections::hashset<LinxcVar*, collections::PointerKeys> *escaped)
+{
+    LinxcFunc *callee = call->call->data.functionCall.func;
+    collections::Array<LinxcExpression> *inputs = &call->call->data.functionCall.inputParams;
+    bool changed = false;
+
+    for (usize i = 0; i < inputs->length; i++)
+    {
+        //a pointer passed to a parameter the callee may store can be reached by anything the callee stores it for
+        if (i < callee->arguments.length && !kept->Contains(&callee->arguments.data[i]))
+        {
+            continue;
+        }
+        LinxcExpression *input = LinxcUncast(&inputs->data[i]);
+        if (input->ID == LinxcExpr_Modified && input->data.modifiedExpression->modification == Linxc_Ampersand)
+        {
+            LinxcVar *local = LinxcAddressedLocal(&input->data.modifiedExpression->expression, call->caller);
+            if (local != NULL && !escaped->Contains(local))
+            {
+                escaped->Add(local);
+                changed = true;
+            }
+        }
+        else if (input->ID == LinxcExpr_Variable && LinxcParamIndex(call->caller, input->data.variable) >= 0 && !kept->Contains(input->data.variable))
+        {
+            kept->Add(input->data.variable);
+            changed = true;
+        }
+    }
+
+    //a parameter of the caller passed on to a parameter that is not restrict may be aliased within the callee
+    for (usize i = 0; i < inputs->length; i++)
+    {
+        if (inputs->data[i].ID != LinxcExpr_Variable)
+        {
+            continue;
+        }
+        i64 callerIndex = LinxcParamIndex(call->caller, inputs->data[i].data.variable);
+        if (callerIndex < 0)
+        {
+            continue;
+        }
+        LinxcVar *callerParam = &call->caller->arguments.data[callerIndex];
+        if (callerParam->isRestrict && !(callerParam->attributes & LinxcAttribute_NoAlias) && !(call->caller->attributes & LinxcAttribute_NoAlias)
+            && (i >= callee->arguments.length || !callee->arguments.data[i].isRestrict))
+        {
+            callerParam->isRestrict = false;
+            changed = true;
+        }
+    }
+
+    //gather the bases of every pointer argument, this first
+    collections::vector<LinxcAliasBase> bases = collections::vector<LinxcAliasBase>(&defaultAllocator);
+    collections::vector<i64> paramIndices = collections::vector<i64>(&defaultAllocator);
+    if (callee->methodOf != NULL)
+    {
+        LinxcAliasBase thisBase;
+        thisBase.kind = LinxcAliasBase_Unknown;
+        thisBase.variable = NULL;
+        if (call->thisExpr != NULL)
+        {
+            thisBase = LinxcBaseOf(call->thisExpr, call->thisIsPointer, call->caller, escaped);
+        }
+        bases.Add(thisBase);
+        paramIndices.Add(-1);
+    }
+    for (usize i = 0; i < inputs->length; i++)
+    {
+        bool paramIsPointer = i < callee->arguments.length && LinxcIsPointerVar(&callee->arguments.data[i]);
+        if (paramIsPointer || inputs->data[i].resolvesTo.pointerCount > 0)
+        {
+            bases.Add(LinxcBaseOf(&inputs->data[i], true, call->caller, escaped));
+            paramIndices.Add(i < callee->arguments.length ? (i64)i : -1);
+        }
+    }
+
+    for (usize i = 0; i < bases.count; i++)
+    {
+        i64 paramIndex = paramIndices.ptr[i];
+        if (paramIndex < 0 || !callee->arguments.data[paramIndex].isRestrict)
+        {
+            continue;
+        }
+        if ((callee->arguments.data[paramIndex].attributes & LinxcAttribute_NoAlias) || (callee->attributes & LinxcAttribute_NoAlias))
+        {
+            continue;
+        }
+        bool distinct = bases.ptr[i].kind != LinxcAliasBase_Unknown;
+        for (usize j = 0; j < bases.count && distinct; j++)
+        {
+            if (j != i && !LinxcBasesDistinct(bases.ptr[i], bases.ptr[j]))
+            {
+                distinct = false;
+            }
+        }
+        if (!distinct)
+        {
+            callee->arguments.data[paramIndex].isRestrict = false;
+            changed = true;
+        }
+    }
+
+    paramIndices.deinit();
+    bases.deinit();
+    return changed;
+}
+
+void LinxcInferRestrict(LinxcNamespace *rootNamespace)
+{
+    collections::vector<LinxcFunc*> funcs = collections::vector<LinxcFunc*>(&defaultAllocator);
+    collections::vector<LinxcVar*> globals = collections::vector<LinxcVar*>(&defaultAllocator);
+    collections::vector<LinxcAliasCall> calls = collections::vector<LinxcAliasCall>(&defaultAllocator);
+    collections::hashmap<LinxcFunc*, LinxcAliasFuncInfo, collections::PointerKeys> infos = collections::hashmap<LinxcFunc*, LinxcAliasFuncInfo, collections::PointerKeys>(&defaultAllocator);
+    collections::hashset<LinxcVar*, collections::PointerKeys> kept = collections::hashset<LinxcVar*, collections::PointerKeys>(&defaultAllocator);
+    collections::hashset<LinxcVar*, collections::PointerKeys> escaped = collections::hashset<LinxcVar*, collections::PointerKeys>(&defaultAllocator);
+
+    LinxcFunc *mainFunc = NULL;
+    LinxcSymbolTable *symbols = &rootNamespace->symbols;
+    for (u32 i = 0; i < symbols->capacity; i++)
+    {
+        if (symbols->slots[i].kind == LinxcSymbol_Func && symbols->slots[i].data.function->name == "Main")
+        {
+            mainFunc = symbols->slots[i].data.function;
+        }
+    }
+    LinxcAliasCollect(rootNamespace, &funcs, &globals, &infos);
+
+    for (usize i = 0; i < funcs.count; i++)
+    {
+        LinxcAliasWalkBody(&funcs.ptr[i]->body, funcs.ptr[i], &calls, &infos, &kept);
+        LinxcAliasWalkBodyEscapes(&funcs.ptr[i]->body, funcs.ptr[i], &escaped);
+    }
+    for (usize i = 0; i < globals.count; i++)
+    {
+        if (globals.ptr[i]->defaultValue.present)
+        {
+            LinxcAliasWalkExpr(&globals.ptr[i]->defaultValue.value, NULL, &calls, &infos, &kept);
+        }
+    }
+    for (usize i = 0; i < calls.count; i++)
+    {
+        LinxcAliasFuncInfo *info = infos.Get(calls.ptr[i].call->data.functionCall.func);
+        if (info != NULL)
+        {
+            info->called = true;
+        }
+    }
+
+    //functions we can't see every call of keep their parameters as they are, unless asserted otherwise.
+    //That is every function but the file-local ones of a program, as a project without a Main is a library, whose functions
+    //may be called from C with aliasing pointers
+    for (usize i = 0; i < funcs.count; i++)
+    {
+        LinxcFunc *func = funcs.ptr[i];
+        LinxcAliasFuncInfo *info = infos.Get(func);
+        for (usize j = 0; j < func->arguments.length; j++)
+        {
+            LinxcVar *arg = &func->arguments.data[j];
+            if ((arg->attributes & LinxcAttribute_NoAlias) || (func->attributes & LinxcAttribute_NoAlias))
+            {
+                arg->isRestrict = LinxcIsPointerVar(arg);
+            }
+            else if (mainFunc == NULL || !func->isFileLocal || !info->called || info->addressTaken)
+            {
+                arg->isRestrict = false;
+            }
+        }
+    }
+
+    //each parameter's restrictness depends on that of its callers' parameters, so iterate until nothing changes
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+        for (usize i = 0; i < calls.count; i++)
+        {
+            if (LinxcAliasCheckCall(calls.Get(i), &kept, &escaped))
+            {
+                changed = true;
+            }
+        }
+    }
+
+    escaped.deinit();
+    kept.deinit();
+    infos.deinit();
+    calls.deinit();
+    globals.deinit();
+    funcs.deinit();
+}
@@ -13,13 +13,4 @@ IAllocator::IAllocator(void *instance, allocFunc AllocateFunc, freeFunc freeFunc
     this->freeFunction = freeFunc;
 }
 
-IAllocator defaultAllocator = IAllocator(NULL, &CAllocator_Allocate, &CAllocator_Free);
-
-void* CAllocator_Allocate(void* instance, usize bytes)
-{
-    return malloc(bytes);
-}
-void CAllocator_Free(void* instance, void* ptr)
-{
-    free(ptr);
-}
\ No newline at end of file
+IAllocator defaultAllocator = IAllocator(NULL, &CAllocator_Allocate, &CAllocator_Free);
\ No newline at end of file
@@ -1,46 +1,338 @@
 #include <ast.hpp>
+#include <builtins.hpp>
 
 u32 LinxcTypeReferenceHash(LinxcTypeReference A)
 {
-    //dont bother with the full name
+    //the ID already accounts for the type and it's template args
     u32 h1 = 7;
-    if (A.lastType != NULL)
+    h1 = ((h1 << 5) + h1) ^ A.ID;
+    h1 = ((h1 << 5) + h1) ^ A.pointerCount;
+    return h1;
+}
+u32 LinxcTypeSpecializationHash(LinxcTypeSpecialization A)
+{
+    u32 h1 = 7;
+    h1 = ((h1 << 5) + h1) ^ A.typeID;
+    for (usize i = 0; i < A.templateArgs.length; i++)
+    {
+        u64 arg = A.templateArgs.data[i];
+        h1 = ((h1 << 5) + h1) ^ (u32)arg;
+        h1 = ((h1 << 5) + h1) ^ (u32)(arg >> 32);
+    }
+    return h1;
+}
+bool LinxcTypeSpecializationEql(LinxcTypeSpecialization A, LinxcTypeSpecialization B)
+{
+    if (A.typeID != B.typeID || A.templateArgs.length != B.templateArgs.length)
     {
-        stringHash(A.lastType->name);
+        return false;
     }
-    u32 h2 = 0;
     for (usize i = 0; i < A.templateArgs.length; i++)
     {
-        h2 = LinxcTypeReferenceHash(A.templateArgs.data[i]);
-        h1 = ((h1 << 5) + h1) ^ h2;
-        //result *= 11 + LinxcTypeReferenceHash(A.templateArgs.data[i]);
+        if (A.templateArgs.data[i] != B.templateArgs.data[i])
+        {
+            return false;
+        }
     }
-    h2 = A.pointerCount;
-    h1 = ((h1 << 5) + h1) ^ h2;
-    return h1;
+    return true;
+}
+
+LinxcTypeTable::LinxcTypeTable()
+{
+    this->allocator = NULL;
+    //IDs 1 to LinxcPrimitive_Count belong to the builtin primitive types
+    this->nextID = LinxcPrimitive_Count + 1;
+    this->specializations = collections::hashmap<LinxcTypeSpecialization, u32, LinxcTypeSpecializationKeys>();
+}
+LinxcTypeTable::LinxcTypeTable(IAllocator *allocator)
+{
+    this->allocator = allocator;
+    //IDs 1 to LinxcPrimitive_Count belong to the builtin primitive types
+    this->nextID = LinxcPrimitive_Count + 1;
+    this->specializations = collections::hashmap<LinxcTypeSpecialization, u32, LinxcTypeSpecializationKeys>(allocator);
 }
-u32 LinxcOperatorImplHash(LinxcOperatorImpl A)
+u32 LinxcTypeTable::NewTypeID()
 {
-    u32 h1 = LinxcTypeReferenceHash(A.myType);
-    u32 h2 = 0;
-    if (A.ID == LinxcOverloadIs_Operator)
+    u32 result = this->nextID;
+    this->nextID += 1;
+    return result;
+}
+u32 LinxcTypeTable::Intern(LinxcTypeReference *reference)
+{
+    if (reference->lastType == NULL)
     {
-        h2 = A.op;
+        reference->ID = 0;
+        return 0;
     }
-    else
+    //non-template references share the ID of the type itself
+    if (reference->templateArgs.length == 0)
+    {
+        reference->ID = reference->lastType->ID;
+        return reference->ID;
+    }
+
+    u64 *args = (u64*)defaultAllocator.Allocate(sizeof(u64) * reference->templateArgs.length);
+    for (usize i = 0; i < reference->templateArgs.length; i++)
+    {
+        LinxcTypeReference *arg = &reference->templateArgs.data[i];
+        if (arg->ID == 0)
+        {
+            this->Intern(arg);
+        }
+        args[i] = (u64)arg->ID | ((u64)arg->pointerCount << 32);
+    }
+    LinxcTypeSpecialization key;
+    key.typeID = reference->lastType->ID;
+    key.templateArgs = collections::Array<u64>(&defaultAllocator, args, reference->templateArgs.length);
+
+    u32 *existing = this->specializations.Get(key);
+    if (existing != NULL)
     {
-        h2 = A.implicit ? 7 : 11;
+        reference->ID = *existing;
+        key.templateArgs.deinit();
+        return reference->ID;
     }
-    h1 = ((h1 << 5) + h1) ^ h2;
 
-    h2 = LinxcTypeReferenceHash(A.otherType);
+    //the stored key must outlive this call, so move it into our own allocator
+    u64 *ownedArgs = (u64*)this->allocator->Allocate(sizeof(u64) * key.templateArgs.length);
+    for (usize i = 0; i < key.templateArgs.length; i++)
+    {
+        ownedArgs[i] = args[i];
+    }
+    key.templateArgs.deinit();
+    key.templateArgs = collections::Array<u64>(this->allocator, ownedArgs, reference->templateArgs.length);
+
+    reference->ID = this->NewTypeID();
+    this->specializations.Add(key, reference->ID);
+    return reference->ID;
+}
+u64 LinxcOperatorImplKey(LinxcOperatorImpl A)
+{
+    return ((u64)A.otherType.ID) | ((u64)(A.otherType.pointerCount & 0xFF) << 32) | ((u64)(A.myType.pointerCount & 0xFF) << 40) | (((u64)A.op & 0xFFFF) << 48);
+}
+static u64 LinxcCastKeyPart(LinxcTypeReference type)
+{
+    return ((u64)type.ID) | ((u64)type.pointerCount << 32);
+}
+u32 LinxcCastKeyHash(LinxcCastKey A)
+{
+    u32 h1 = (u32)A.fromType ^ ((u32)(A.fromType >> 32) * 31);
+    u32 h2 = (u32)A.toType ^ ((u32)(A.toType >> 32) * 31);
     return ((h1 << 5) + h1) ^ h2;
 }
-bool LinxcOperatorImplEql(LinxcOperatorImpl A, LinxcOperatorImpl B)
+bool LinxcCastKeyEql(LinxcCastKey A, LinxcCastKey B)
+{
+    return A.fromType == B.fromType && A.toType == B.toType;
+}
+LinxcOperatorSlot LinxcGetOperatorSlot(LinxcTokenID op)
+{
+    switch (op)
+    {
+        case Linxc_Equal:
+            return LinxcOperatorSlot_Equal;
+        case Linxc_Plus:
+            return LinxcOperatorSlot_Plus;
+        case Linxc_Minus:
+            return LinxcOperatorSlot_Minus;
+        case Linxc_Asterisk:
+            return LinxcOperatorSlot_Asterisk;
+        case Linxc_Slash:
+            return LinxcOperatorSlot_Slash;
+        case Linxc_EqualEqual:
+            return LinxcOperatorSlot_EqualEqual;
+        case Linxc_BangEqual:
+            return LinxcOperatorSlot_BangEqual;
+        case Linxc_AmpersandAmpersand:
+            return LinxcOperatorSlot_AmpersandAmpersand;
+        case Linxc_PipePipe:
+            return LinxcOperatorSlot_PipePipe;
+        default:
+            return LinxcOperatorSlot_None;
+    }
+}
+
+LinxcOperatorOverloads::LinxcOperatorOverloads()
+{
+    this->entries = collections::vector<LinxcOperatorEntry>();
+}
+LinxcOperatorOverloads::LinxcOperatorOverloads(IAllocator *allocator)
+{
+    this->entries = collections::vector<LinxcOperatorEntry>(allocator);
+}
+void LinxcOperatorOverloads::Add(u64 key, LinxcOperatorFunc *func)
+{
+    usize index = 0;
+    while (index < this->entries.count && this->entries.ptr[index].key < key)
+    {
+        index++;
+    }
+    if (index < this->entries.count && this->entries.ptr[index].key == key)
+    {
+        this->entries.ptr[index].func = func;
+        return;
+    }
+
+    LinxcOperatorEntry entry;
+    entry.key = key;
+    entry.func = func;
+    this->entries.Add(entry);
+    //shift everything after the insertion point up by one
+    for (usize i = this->entries.count - 1; i > index; i--)
+    {
+        this->entries.ptr[i] = this->entries.ptr[i - 1];
+    }
+    this->entries.ptr[index] = entry;
+}
+LinxcOperatorFunc *LinxcOperatorOverloads::Get(u64 key)
+{
+    usize low = 0;
+    usize high = this->entries.count;
+    while (low < high)
+    {
+        usize middle = low + (high - low) / 2;
+        u64 middleKey = this->entries.ptr[middle].key;
+        if (middleKey == key)
+        {
+            return this->entries.ptr[middle].func;
+        }
+        else if (middleKey < key)
+        {
+            low = middle + 1;
+        }
+        else high = middle;
+    }
+    return NULL;
+}
+
+LinxcOperatorIndex::LinxcOperatorIndex()
+{
+    this->userCasts = collections::hashmap<LinxcCastKey, LinxcOperatorFunc*, LinxcCastKeys>();
+}
+void LinxcOperatorIndex::deinit()
+{
+    this->userCasts.deinit();
+}
+void LinxcOperatorIndex::Add(LinxcOperatorFunc *func)
+{
+    LinxcOperatorImpl *impl = &func->operatorOverride;
+    if (impl->ID == LinxcOverloadIs_Cast)
+    {
+        LinxcCastKey key;
+        key.fromType = LinxcCastKeyPart(impl->myType);
+        key.toType = LinxcCastKeyPart(impl->otherType);
+        this->userCasts.Add(key, func);
+    }
+    else impl->myType.lastType->operatorOverloads.Add(LinxcOperatorImplKey(*impl), func);
+}
+LinxcOperatorFunc *LinxcOperatorIndex::FindOperator(LinxcTypeReference myType, LinxcTokenID op, LinxcTypeReference otherType)
+{
+    if (myType.lastType == NULL || otherType.lastType == NULL)
+    {
+        return NULL;
+    }
+    LinxcOperatorImpl key;
+    key.ID = LinxcOverloadIs_Operator;
+    key.implicit = false;
+    key.op = op;
+    key.myType = myType;
+    key.otherType = otherType;
+
+    LinxcOperatorFunc *result = myType.lastType->operatorOverloads.Get(LinxcOperatorImplKey(key));
+    if (result == NULL)
+    {
+        //typeA op typeB may be defined on typeB instead
+        key.myType = otherType;
+        key.otherType = myType;
+        result = otherType.lastType->operatorOverloads.Get(LinxcOperatorImplKey(key));
+    }
+    return result;
+}
+LinxcOperatorFunc *LinxcOperatorIndex::FindCast(LinxcTypeReference myType, LinxcTypeReference toType, bool implicitly)
 {
-    //If A is implicit and B is explicit but they resolve to the same value, then the cast is considered equal.
-    //Thus, there is no need to check their implicity
-    return A.myType == B.myType && A.otherType == B.otherType && A.ID == B.ID && A.op == B.op && A.implicit == B.implicit;
+    if (this->userCasts.Count == 0)
+    {
+        return NULL;
+    }
+    LinxcCastKey key;
+    key.fromType = LinxcCastKeyPart(myType);
+    key.toType = LinxcCastKeyPart(toType);
+
+    LinxcOperatorFunc **result = this->userCasts.Get(key);
+    if (result == NULL || (implicitly && !(*result)->operatorOverride.implicit))
+    {
+        return NULL;
+    }
+    return *result;
+}
+bool LinxcOperatorIndex::CanCast(LinxcTypeReference myType, LinxcTypeReference toType, bool implicitly)
+{
+    if (myType.lastType == NULL || toType.lastType == NULL)
+    {
+        return false;
+    }
+    LinxcPrimitiveID myPrimitive = myType.lastType->primitiveID;
+    LinxcPrimitiveID toPrimitive = toType.lastType->primitiveID;
+    if (myPrimitive != LinxcPrimitive_None && toPrimitive != LinxcPrimitive_None && myType.pointerCount == 0 && toType.pointerCount == 0)
+    {
+        return LinxcBuiltinCanCast(myPrimitive, toPrimitive, implicitly);
+    }
+    return this->FindCast(myType, toType, implicitly) != NULL;
+}
+option<LinxcTypeReference> LinxcOperatorIndex::ResolveOperator(LinxcTypeReference myType, LinxcTokenID op, LinxcTypeReference otherType, LinxcOperatorFunc **overload)
+{
+    *overload = NULL;
+    if (myType.lastType == NULL || otherType.lastType == NULL)
+    {
+        return option<LinxcTypeReference>();
+    }
+    LinxcPrimitiveID myPrimitive = myType.lastType->primitiveID;
+    LinxcPrimitiveID otherPrimitive = otherType.lastType->primitiveID;
+    if (myPrimitive != LinxcPrimitive_None && otherPrimitive != LinxcPrimitive_None && myType.pointerCount == 0 && otherType.pointerCount == 0)
+    {
+        LinxcOperatorSlot slot = LinxcGetOperatorSlot(op);
+        if (slot != LinxcOperatorSlot_None)
+        {
+            LinxcPrimitiveID result = LinxcBuiltinOperatorResult(slot, myPrimitive, otherPrimitive);
+            if (result != LinxcPrimitive_None)
+            {
+                return option<LinxcTypeReference>(LinxcTypeReference(LinxcGetPrimitiveType(result)));
+            }
+        }
+        return option<LinxcTypeReference>();
+    }
+
+    LinxcOperatorFunc *func = this->FindOperator(myType, op, otherType);
+    if (func != NULL)
+    {
+        *overload = func;
+        //todo: precalculate these?
+        return option<LinxcTypeReference>(func->function.returnType.AsTypeReference());
+    }
+    return option<LinxcTypeReference>();
+}
+option<LinxcTypeReference> LinxcOperatorIndex::ResolveCast(LinxcTypeReference myType, LinxcTypeReference toType, bool implicitly)
+{
+    if (myType.lastType == NULL || toType.lastType == NULL)
+    {
+        return option<LinxcTypeReference>();
+    }
+    LinxcPrimitiveID myPrimitive = myType.lastType->primitiveID;
+    LinxcPrimitiveID toPrimitive = toType.lastType->primitiveID;
+    if (myPrimitive != LinxcPrimitive_None && toPrimitive != LinxcPrimitive_None && myType.pointerCount == 0 && toType.pointerCount == 0)
+    {
+        if (LinxcBuiltinCanCast(myPrimitive, toPrimitive, implicitly))
+        {
+            return option<LinxcTypeReference>(LinxcTypeReference(toType.lastType));
+        }
+        return option<LinxcTypeReference>();
+    }
+
+    LinxcOperatorFunc *func = this->FindCast(myType, toType, implicitly);
+    if (func != NULL)
+    {
+        return option<LinxcTypeReference>(func->function.returnType.AsTypeReference());
+    }
+    return option<LinxcTypeReference>();
 }
 string LinxcOperatorImpl::ToString(IAllocator* allocator)
 {
@@ -75,15 +367,14 @@ string LinxcOperatorFunc::ToString(IAllocator* allocator)
     result.AppendDeinit(this->function.returnType.AsTypeReference().value.ToString(&defaultAllocator));
     return result;
 }
-option<LinxcTypeReference> LinxcOperator::EvaluatePossible()
+option<LinxcTypeReference> LinxcOperator::EvaluatePossible(LinxcOperatorIndex *index)
 {
+    this->overload = NULL;
     //if we are scope resolution operators, simply return the type of the rightmost member
     if (this->operatorType == Linxc_ColonColon || this->operatorType == Linxc_Period || this->operatorType == Linxc_Arrow)
     {
         return option<LinxcTypeReference>(this->rightExpr.resolvesTo);
     }
-    LinxcOperatorImpl key;
-    LinxcOperatorFunc* result = NULL;
     if (this->operatorType == Linxc_Equal)
     {
         if (this->rightExpr.resolvesTo == this->leftExpr.resolvesTo)
@@ -93,48 +384,14 @@ option<LinxcTypeReference> LinxcOperator::EvaluatePossible()
         //if the operator is =, don't bother checking whether typeA = typeB, as Linxc
         //dictates that only typeA = typeA, however, a implicit cast may be performed on
         //typeB to convert it to typeA, so check that instead
-
-        key.ID = LinxcOverloadIs_Cast;
-        key.implicit = true;
-        key.myType = this->rightExpr.resolvesTo;
-        key.otherType = this->leftExpr.resolvesTo;
-        key.op = Linxc_Invalid;
-
-        result = this->rightExpr.resolvesTo.lastType->operatorOverloads.Get(key);
-        if (result != NULL)
+        option<LinxcTypeReference> castResult = index->ResolveCast(this->rightExpr.resolvesTo, this->leftExpr.resolvesTo, true);
+        if (castResult.present)
         {
-            return option<LinxcTypeReference>(result->function.returnType.AsTypeReference());
+            return castResult;
         }
     }
 
-    key.ID = LinxcOverloadIs_Operator;
-    key.implicit = false;
-    key.myType = this->leftExpr.resolvesTo;
-    key.otherType = this->rightExpr.resolvesTo;
-    key.op = this->operatorType;
-
-    result = this->leftExpr.resolvesTo.lastType->operatorOverloads.Get(key);
-    if (result != NULL)
-    {
-        //todo: precalculate these?
-        return option<LinxcTypeReference>(result->function.returnType.AsTypeReference());
-    }
-    else
-    {
-        key.ID = LinxcOverloadIs_Operator;
-        key.implicit = false;
-        key.myType = this->rightExpr.resolvesTo;
-        key.otherType = this->leftExpr.resolvesTo;
-        key.op = this->operatorType;
-
-        result = this->rightExpr.resolvesTo.lastType->operatorOverloads.Get(key);
-        if (result != NULL)
-        {
-            return option<LinxcTypeReference>(result->function.returnType.AsTypeReference());
-        }
-
-        return option<LinxcTypeReference>();
-    }
+    return index->ResolveOperator(this->leftExpr.resolvesTo, this->operatorType, this->rightExpr.resolvesTo, &this->overload);
 }
 
 LinxcParsedFile::LinxcParsedFile()
@@ -163,6 +420,7 @@ LinxcParsedFile::LinxcParsedFile(IAllocator *allocator, string fullPath, string
 LinxcTypeReference::LinxcTypeReference()
 {
     this->lastType = NULL;
+    this->ID = 0;
     this->pointerCount = 0;
     this->isConst = false;
     this->templateArgs = collections::Array<LinxcTypeReference>();
@@ -170,43 +428,209 @@ LinxcTypeReference::LinxcTypeReference()
 LinxcTypeReference::LinxcTypeReference(LinxcType *type)
 {
     this->lastType = type;
+    this->ID = type != NULL ? type->ID : 0;
     this->pointerCount = 0;
     this->isConst = false;
     this->templateArgs = collections::Array<LinxcTypeReference>();
 }
-bool LinxcTypeReference::CanCastTo(LinxcTypeReference type, bool implicitly)
+bool LinxcTypeReference::CanCastTo(LinxcTypeReference type, bool implicitly, LinxcOperatorIndex *index)
 {
     //any pointer type can cast to void pointer type
-    if (this->pointerCount > 0 && type.pointerCount > 0 && type.lastType->name == "void")
+    if (this->pointerCount > 0 && type.pointerCount > 0 && type.lastType->primitiveID == LinxcPrimitive_void)
     {
         return true;
     }
-    LinxcOperatorImpl castImpl;
-    castImpl.ID = LinxcOverloadIs_Cast;
-    castImpl.implicit = implicitly;
-    castImpl.myType = *this;
-    castImpl.op = Linxc_Invalid;
-    castImpl.otherType = type;
-    return lastType->operatorOverloads.Contains(castImpl);
+    return index->CanCast(*this, type, implicitly);
+}
+
+string *LinxcSymbol::GetName()
+{
+    switch (this->kind)
+    {
+        case LinxcSymbol_Func:
+            return &this->data.function->name;
+        case LinxcSymbol_Var:
+            return &this->data.variable->name;
+        case LinxcSymbol_Type:
+            return &this->data.type->name;
+        case LinxcSymbol_Namespace:
+            return &this->data.namespaceRef->name;
+        default:
+            return NULL;
+    }
+}
+
+LinxcSymbolTable::LinxcSymbolTable()
+{
+    this->allocator = &defaultAllocator;
+    this->slots = NULL;
+    this->capacity = 0;
+    this->count = 0;
+}
+LinxcSymbolTable::LinxcSymbolTable(IAllocator *allocator)
+{
+    this->allocator = allocator;
+    this->slots = NULL;
+    this->capacity = 0;
+    this->count = 0;
+}
+static void LinxcSymbolTableInsert(LinxcSymbol *slots, u32 capacity, LinxcSymbol symbol)
+{
+    u32 mask = capacity - 1;
+    u32 index = symbol.hash & mask;
+    while (slots[index].kind != LinxcSymbol_None)
+    {
+        index = (index + 1) & mask;
+    }
+    slots[index] = symbol;
+}
+void LinxcSymbolTable::Add(LinxcSymbolKind kind, LinxcSymbolData data)
+{
+    LinxcSymbol symbol;
+    symbol.kind = kind;
+    symbol.data = data;
+    string *name = symbol.GetName();
+    symbol.hash = charHash(name->buffer);
+
+    LinxcSymbol *existing = this->Find(*name, kind);
+    if (existing != NULL)
+    {
+        *existing = symbol;
+        return;
+    }
+
+    //grow at a load factor of 0.75
+    if ((this->count + 1) * 4 > this->capacity * 3)
+    {
+        u32 newCapacity = this->capacity == 0 ? 8 : this->capacity * 2;
+        LinxcSymbol *newSlots = (LinxcSymbol*)this->allocator->Allocate(newCapacity * sizeof(LinxcSymbol));
+        for (u32 i = 0; i < newCapacity; i++)
+        {
+            newSlots[i].kind = LinxcSymbol_None;
+        }
+        for (u32 i = 0; i < this->capacity; i++)
+        {
+            if (this->slots[i].kind != LinxcSymbol_None)
+            {
+                LinxcSymbolTableInsert(newSlots, newCapacity, this->slots[i]);
+            }
+        }
+        if (this->slots != NULL)
+        {
+            this->allocator->Free((void**)&this->slots);
+        }
+        this->slots = newSlots;
+        this->capacity = newCapacity;
+    }
+    LinxcSymbolTableInsert(this->slots, this->capacity, symbol);
+    this->count += 1;
+}
+LinxcSymbol *LinxcSymbolTable::Find(string name, LinxcSymbolKind kind)
+{
+    if (this->count == 0 || name.buffer == NULL)
+    {
+        return NULL;
+    }
+    u32 hash = charHash(name.buffer);
+    u32 mask = this->capacity - 1;
+    u32 index = hash & mask;
+    while (this->slots[index].kind != LinxcSymbol_None)
+    {
+        LinxcSymbol *symbol = &this->slots[index];
+        if (symbol->hash == hash && (kind == LinxcSymbol_None || symbol->kind == kind) && symbol->GetName()->eql(name.buffer))
+        {
+            return symbol;
+        }
+        index = (index + 1) & mask;
+    }
+    return NULL;
+}
+LinxcSymbol *LinxcSymbolTable::Find(string name)
+{
+    if (this->count == 0 || name.buffer == NULL)
+    {
+        return NULL;
+    }
+    //a name may be shared by entities of different kinds, so walk the whole probe sequence and keep the best one
+    LinxcSymbol *result = NULL;
+    u32 hash = charHash(name.buffer);
+    u32 mask = this->capacity - 1;
+    u32 index = hash & mask;
+    while (this->slots[index].kind != LinxcSymbol_None)
+    {
+        LinxcSymbol *symbol = &this->slots[index];
+        if (symbol->hash == hash && (result == NULL || symbol->kind < result->kind) && symbol->GetName()->eql(name.buffer))
+        {
+            result = symbol;
+        }
+        index = (index + 1) & mask;
+    }
+    return result;
 }
 
 LinxcNamespace::LinxcNamespace()
 {
     this->parentNamespace = NULL;
     this->name = string();
-    this->functions = collections::hashmap<string, LinxcFunc>();
-    this->subNamespaces = collections::hashmap<string, LinxcNamespace>();
-    this->types = collections::hashmap<string, LinxcType>();
-    this->variables = collections::hashmap<string, LinxcVar>();
+    this->symbols = LinxcSymbolTable();
 }
 LinxcNamespace::LinxcNamespace(IAllocator *allocator, string name)
 {
     this->parentNamespace = NULL;
     this->name = name;
-    this->functions = collections::hashmap<string, LinxcFunc>(allocator, &stringHash, &stringEql);
-    this->subNamespaces = collections::hashmap<string, LinxcNamespace>(allocator, &stringHash, &stringEql);
-    this->types = collections::hashmap<string, LinxcType>(allocator, &stringHash, &stringEql);
-    this->variables = collections::hashmap<string, LinxcVar>(allocator, &stringHash, &stringEql);
+    this->symbols = LinxcSymbolTable(allocator);
+}
+LinxcVar *LinxcNamespace::AddVar(LinxcVar var)
+{
+    LinxcSymbolData data;
+    data.variable = (LinxcVar*)this->symbols.allocator->Allocate(sizeof(LinxcVar));
+    *data.variable = var;
+    this->symbols.Add(LinxcSymbol_Var, data);
+    return data.variable;
+}
+LinxcFunc *LinxcNamespace::AddFunction(LinxcFunc func)
+{
+    LinxcSymbolData data;
+    data.function = (LinxcFunc*)this->symbols.allocator->Allocate(sizeof(LinxcFunc));
+    *data.function = func;
+    this->symbols.Add(LinxcSymbol_Func, data);
+    return data.function;
+}
+LinxcType *LinxcNamespace::AddType(LinxcType type)
+{
+    LinxcSymbolData data;
+    data.type = (LinxcType*)this->symbols.allocator->Allocate(sizeof(LinxcType));
+    *data.type = type;
+    this->symbols.Add(LinxcSymbol_Type, data);
+    return data.type;
+}
+LinxcNamespace *LinxcNamespace::AddNamespace(LinxcNamespace subNamespace)
+{
+    LinxcSymbolData data;
+    data.namespaceRef = (LinxcNamespace*)this->symbols.allocator->Allocate(sizeof(LinxcNamespace));
+    *data.namespaceRef = subNamespace;
+    this->symbols.Add(LinxcSymbol_Namespace, data);
+    return data.namespaceRef;
+}
+LinxcVar *LinxcNamespace::FindVar(string name)
+{
+    LinxcSymbol *symbol = this->symbols.Find(name, LinxcSymbol_Var);
+    return symbol != NULL ? symbol->data.variable : NULL;
+}
+LinxcFunc *LinxcNamespace::FindFunction(string name)
+{
+    LinxcSymbol *symbol = this->symbols.Find(name, LinxcSymbol_Func);
+    return symbol != NULL ? symbol->data.function : NULL;
+}
+LinxcType *LinxcNamespace::FindType(string name)
+{
+    LinxcSymbol *symbol = this->symbols.Find(name, LinxcSymbol_Type);
+    return symbol != NULL ? symbol->data.type : NULL;
+}
+LinxcNamespace *LinxcNamespace::FindNamespace(string name)
+{
+    LinxcSymbol *symbol = this->symbols.Find(name, LinxcSymbol_Namespace);
+    return symbol != NULL ? symbol->data.namespaceRef : NULL;
 }
 LinxcNamespaceScope::LinxcNamespaceScope()
 {
@@ -227,8 +651,26 @@ LinxcType::LinxcType()
     this->functions = collections::vector<LinxcFunc>();
     this->subTypes = collections::vector<LinxcType>();
     this->templateArgs = collections::vector<string>();
+    this->templateParams = collections::Array<LinxcType>();
+    this->templateParamIndex = -1;
+    this->templateOf = NULL;
+    this->instanceArgs = collections::Array<LinxcTypeReference>();
+    this->isDependent = false;
     this->variables = collections::vector<LinxcVar>();
-    this->operatorOverloads = collections::hashmap<LinxcOperatorImpl, LinxcOperatorFunc>();
+    this->operatorOverloads = LinxcOperatorOverloads();
+    this->primitiveID = LinxcPrimitive_None;
+    this->ID = 0;
+    this->memberIndex = LinxcMemberIndex();
+    this->cName = NULL;
+    this->fullName = NULL;
+    this->attributes = LinxcAttribute_None;
+    this->isReachable = true;
+    this->size = 0;
+    this->alignment = 0;
+    this->padding = 0;
+    this->offsets = collections::Array<usize>();
+    this->fieldOrder = collections::Array<u32>();
+    this->layoutComputed = false;
 }
 LinxcType::LinxcType(IAllocator *allocator, string name, LinxcNamespace *myNamespace, LinxcType *myParent)
 {
@@ -239,75 +681,234 @@ LinxcType::LinxcType(IAllocator *allocator, string name, LinxcNamespace *myNames
     this->functions = collections::vector<LinxcFunc>(allocator);
     this->subTypes = collections::vector<LinxcType>(allocator);
     this->templateArgs = collections::vector<string>(allocator);
+    this->templateParams = collections::Array<LinxcType>();
+    this->templateParamIndex = -1;
+    this->templateOf = NULL;
+    this->instanceArgs = collections::Array<LinxcTypeReference>();
+    this->isDependent = false;
     this->variables = collections::vector<LinxcVar>(allocator);
-    this->operatorOverloads = collections::hashmap<LinxcOperatorImpl, LinxcOperatorFunc>(allocator, &LinxcOperatorImplHash, &LinxcOperatorImplEql);
+    this->operatorOverloads = LinxcOperatorOverloads(allocator);
+    this->primitiveID = LinxcPrimitive_None;
+    this->ID = 0;
+    this->memberIndex = LinxcMemberIndex();
+    this->cName = NULL;
+    this->fullName = NULL;
+    this->attributes = LinxcAttribute_None;
+    this->isReachable = true;
+    this->size = 0;
+    this->alignment = 0;
+    this->padding = 0;
+    this->offsets = collections::Array<usize>();
+    this->fieldOrder = collections::Array<u32>();
+    this->layoutComputed = false;
 }
-string LinxcType::GetFullName(IAllocator *allocator)
+//Joins the names of all named namespaces enclosing nameSpace and name with separator, in a single allocation.
+//Returns name itself if there is nothing to prefix it with.
+static const char *LinxcQualifiedName(IAllocator *allocator, LinxcNamespace *nameSpace, const char *name, const char *separator)
 {
-    string result = string();
-    result.allocator = allocator;
+    usize separatorLength = strlen(separator);
+    usize nameLength = strlen(name);
+    usize length = nameLength;
+    for (LinxcNamespace *currentNamespace = nameSpace; currentNamespace != NULL; currentNamespace = currentNamespace->parentNamespace)
+    {
+        if (currentNamespace->name.buffer != NULL)
+        {
+            length += strlen(currentNamespace->name.buffer) + separatorLength;
+        }
+    }
+    if (length == nameLength)
+    {
+        return name;
+    }
 
-    LinxcNamespace *currentNamespace = this->typeNamespace;
-    while (currentNamespace != NULL && currentNamespace->name.buffer != NULL)
+    //fill back to front, as we walk namespaces from innermost to outermost
+    char *result = (char*)allocator->Allocate(length + 1);
+    result[length] = '\0';
+    usize end = length - nameLength;
+    memcpy(result + end, name, nameLength);
+    for (LinxcNamespace *currentNamespace = nameSpace; currentNamespace != NULL; currentNamespace = currentNamespace->parentNamespace)
     {
-        result.Prepend("::");
-        result.Prepend(currentNamespace->name.buffer);
-        currentNamespace = currentNamespace->parentNamespace;
+        if (currentNamespace->name.buffer != NULL)
+        {
+            end -= separatorLength;
+            memcpy(result + end, separator, separatorLength);
+            usize namespaceLength = strlen(currentNamespace->name.buffer);
+            end -= namespaceLength;
+            memcpy(result + end, currentNamespace->name.buffer, namespaceLength);
+        }
     }
-    result.Append(this->name.buffer);
-    
     return result;
 }
-string LinxcType::GetCName(IAllocator* allocator)
+const char *LinxcType::GetFullName(IAllocator *allocator)
 {
-    string result = string(&defaultAllocator);
+    if (this->fullName == NULL)
+    {
+        this->fullName = LinxcQualifiedName(allocator, this->typeNamespace, this->name.buffer, "::");
+    }
+    return this->fullName;
+}
+const char *LinxcType::GetCName(IAllocator* allocator)
+{
+    if (this->cName == NULL)
+    {
+        this->cName = LinxcQualifiedName(allocator, this->typeNamespace, this->name.buffer, "_");
+    }
+    return this->cName;
+}
+LinxcMemberIndex::LinxcMemberIndex()
+{
+    this->slots = NULL;
+    this->capacity = 0;
+    this->variablesCount = 0;
+    this->functionsCount = 0;
+    this->subTypesCount = 0;
+}
+static void LinxcMemberIndexInsert(LinxcMemberIndex *index, string name, u32 memberIndex, LinxcMemberKind kind)
+{
+    if (name.buffer == NULL)
+    {
+        return;
+    }
+    u32 hash = charHash(name.buffer);
+    usize mask = index->capacity - 1;
+    usize slot = hash & mask;
+    while (index->slots[slot].kind != LinxcMember_None)
+    {
+        slot = (slot + 1) & mask;
+    }
+    index->slots[slot].hash = hash;
+    index->slots[slot].index = memberIndex;
+    index->slots[slot].kind = kind;
+}
+void LinxcType::RebuildMemberIndex()
+{
+    IAllocator *allocator = this->variables.allocator;
+    usize membersCount = this->variables.count + this->functions.count + this->subTypes.count;
 
-    LinxcNamespace* currentNamespace = this->typeNamespace;
-    while (currentNamespace != NULL)
+    //keep the load factor at or below 0.5 so probe sequences stay short
+    usize capacity = 16;
+    while (capacity < membersCount * 2)
     {
-        if (currentNamespace->name.buffer != NULL)
+        capacity *= 2;
+    }
+    if (capacity != this->memberIndex.capacity)
+    {
+        if (this->memberIndex.slots != NULL)
         {
-            result.Prepend("_");
-            result.Prepend(currentNamespace->name.buffer);
+            allocator->Free((void**)&this->memberIndex.slots);
         }
-        currentNamespace = currentNamespace->parentNamespace;
+        this->memberIndex.slots = (LinxcMemberSlot*)allocator->Allocate(capacity * sizeof(LinxcMemberSlot));
+        this->memberIndex.capacity = capacity;
+    }
+    for (usize i = 0; i < capacity; i++)
+    {
+        this->memberIndex.slots[i].kind = LinxcMember_None;
     }
-    result.Append(this->name.buffer);
 
-    return result.CloneDeinit(allocator);
-}
-LinxcFunc *LinxcType::FindFunction(string name)
-{
+    for (usize i = 0; i < this->variables.count; i++)
+    {
+        LinxcMemberIndexInsert(&this->memberIndex, this->variables.ptr[i].name, (u32)i, LinxcMember_Var);
+    }
     for (usize i = 0; i < this->functions.count; i++)
     {
-        if (this->functions.Get(i)->name.eql(name.buffer))
-        {
-            return this->functions.Get(i);
-        }
+        LinxcMemberIndexInsert(&this->memberIndex, this->functions.ptr[i].name, (u32)i, LinxcMember_Func);
     }
-    return NULL;
+    for (usize i = 0; i < this->subTypes.count; i++)
+    {
+        LinxcMemberIndexInsert(&this->memberIndex, this->subTypes.ptr[i].name, (u32)i, LinxcMember_Type);
+    }
+    this->memberIndex.variablesCount = this->variables.count;
+    this->memberIndex.functionsCount = this->functions.count;
+    this->memberIndex.subTypesCount = this->subTypes.count;
 }
-LinxcType *LinxcType::FindSubtype(string name)
+i64 LinxcType::FindMember(string name, LinxcMemberKind kind)
 {
-    for (usize i = 0; i < this->subTypes.count; i++)
+    usize membersCount = this->variables.count + this->functions.count + this->subTypes.count;
+    if (membersCount <= LINXC_MEMBER_INDEX_THRESHOLD)
     {
-        if (this->subTypes.Get(i)->name.eql(name.buffer))
+        //small types are faster to scan than to hash
+        switch (kind)
         {
-            return this->subTypes.Get(i);
+            case LinxcMember_Var:
+                for (usize i = 0; i < this->variables.count; i++)
+                {
+                    if (this->variables.ptr[i].name.eql(name.buffer))
+                    {
+                        return (i64)i;
+                    }
+                }
+                break;
+            case LinxcMember_Func:
+                for (usize i = 0; i < this->functions.count; i++)
+                {
+                    if (this->functions.ptr[i].name.eql(name.buffer))
+                    {
+                        return (i64)i;
+                    }
+                }
+                break;
+            case LinxcMember_Type:
+                for (usize i = 0; i < this->subTypes.count; i++)
+                {
+                    if (this->subTypes.ptr[i].name.eql(name.buffer))
+                    {
+                        return (i64)i;
+                    }
+                }
+                break;
+            default:
+                break;
         }
+        return -1;
     }
-    return NULL;
-}
-LinxcVar *LinxcType::FindVar(string name)
-{
-    for (usize i = 0; i < this->variables.count; i++)
+
+    if (this->memberIndex.slots == NULL || this->memberIndex.variablesCount != this->variables.count || this->memberIndex.functionsCount != this->functions.count || this->memberIndex.subTypesCount != this->subTypes.count)
     {
-        if (this->variables.Get(i)->name.eql(name.buffer))
+        this->RebuildMemberIndex();
+    }
+
+    u32 hash = charHash(name.buffer);
+    usize mask = this->memberIndex.capacity - 1;
+    usize slot = hash & mask;
+    while (this->memberIndex.slots[slot].kind != LinxcMember_None)
+    {
+        LinxcMemberSlot *current = &this->memberIndex.slots[slot];
+        if (current->hash == hash && current->kind == kind)
         {
-            return this->variables.Get(i);
+            string *memberName;
+            if (kind == LinxcMember_Var)
+            {
+                memberName = &this->variables.ptr[current->index].name;
+            }
+            else if (kind == LinxcMember_Func)
+            {
+                memberName = &this->functions.ptr[current->index].name;
+            }
+            else memberName = &this->subTypes.ptr[current->index].name;
+
+            if (memberName->eql(name.buffer))
+            {
+                return (i64)current->index;
+            }
         }
+        slot = (slot + 1) & mask;
     }
-    return NULL;
+    return -1;
+}
+LinxcFunc *LinxcType::FindFunction(string name)
+{
+    i64 index = this->FindMember(name, LinxcMember_Func);
+    return index >= 0 ? this->functions.Get((usize)index) : NULL;
+}
+LinxcType *LinxcType::FindSubtype(string name)
+{
+    i64 index = this->FindMember(name, LinxcMember_Type);
+    return index >= 0 ? this->subTypes.Get((usize)index) : NULL;
+}
+LinxcVar *LinxcType::FindVar(string name)
+{
+    i64 index = this->FindMember(name, LinxcMember_Var);
+    return index >= 0 ? this->variables.Get((usize)index) : NULL;
 }
 LinxcExpression LinxcType::AsExpression()
 {
@@ -325,6 +926,10 @@ LinxcVar::LinxcVar()
     this->name = string();
     this->type = LinxcExpression();
     this->defaultValue = option<LinxcExpression>();
+    this->attributes = LinxcAttribute_None;
+    this->isRestrict = false;
+    this->isFileLocal = false;
+    this->isPassedByPointer = false;
 }
 LinxcVar::LinxcVar(string varName, LinxcExpression varType, option<LinxcExpression> defaultVal)
 {
@@ -332,6 +937,10 @@ LinxcVar::LinxcVar(string varName, LinxcExpression varType, option<LinxcExpressi
     this->name = varName;
     this->type = varType;
     this->defaultValue = defaultVal;
+    this->attributes = LinxcAttribute_None;
+    this->isRestrict = false;
+    this->isFileLocal = false;
+    this->isPassedByPointer = false;
 }
 string LinxcVar::ToString(IAllocator *allocator)
 {
@@ -348,6 +957,11 @@ LinxcFunc::LinxcFunc()
     this->arguments = collections::Array<LinxcVar>();
     this->templateArgs = collections::Array<string>();
     this->necessaryArguments = 0;
+    this->cName = NULL;
+    this->attributes = LinxcAttribute_None;
+    this->isReachable = true;
+    this->isFileLocal = false;
+    this->returnsThroughPointer = false;
 }
 LinxcFunc::LinxcFunc(string name, LinxcExpression returnType)
 {
@@ -359,29 +973,31 @@ LinxcFunc::LinxcFunc(string name, LinxcExpression returnType)
     this->arguments = collections::Array<LinxcVar>();
     this->templateArgs = collections::Array<string>();
     this->necessaryArguments = 0;
+    this->cName = NULL;
+    this->attributes = LinxcAttribute_None;
+    this->isReachable = true;
+    this->isFileLocal = false;
+    this->returnsThroughPointer = false;
 }
-string LinxcFunc::GetCName(IAllocator *allocator)
+const char *LinxcFunc::GetCName(IAllocator *allocator)
 {
-    string result = string(&defaultAllocator);
-
-    if (this->methodOf != NULL)
-    {
-        result.Prepend("_");
-        string typeCName = this->methodOf->GetCName(&defaultAllocator);
-        result.Prepend(typeCName.buffer);
-        typeCName.deinit();
-    }
-
-    /*LinxcNamespace* currentNamespace = this->funcNamespace;
-    while (currentNamespace != NULL && currentNamespace->name.buffer != NULL)
+    if (this->cName == NULL)
     {
-        result.Prepend("_");
-        result.Prepend(currentNamespace->name.buffer);
-        currentNamespace = currentNamespace->parentNamespace;
-    }*/
-    result.Append(this->name.buffer);
+        if (this->methodOf != NULL)
+        {
+            const char *typeCName = this->methodOf->GetCName(allocator);
+            usize typeLength = strlen(typeCName);
+            usize nameLength = strlen(this->name.buffer);
 
-    return result.CloneDeinit(allocator);
+            char *result = (char*)allocator->Allocate(typeLength + 1 + nameLength + 1);
+            memcpy(result, typeCName, typeLength);
+            result[typeLength] = '_';
+            memcpy(result + typeLength + 1, this->name.buffer, nameLength + 1);
+            this->cName = result;
+        }
+        else this->cName = this->name.buffer;
+    }
+    return this->cName;
 }
 
 string LinxcFunctionCall::ToString(IAllocator *allocator)
@@ -408,7 +1024,7 @@ string LinxcTypeReference::ToString(IAllocator *allocator)
     {
         result.Append("const ");
     }
-    result.AppendDeinit(this->lastType->GetFullName(&defaultAllocator));
+    result.Append(this->lastType->GetFullName(&defaultAllocator));
     for (i32 i = 0; i < this->pointerCount; i++)
     {
         result.Append("*");
@@ -417,17 +1033,24 @@ string LinxcTypeReference::ToString(IAllocator *allocator)
 }
 string LinxcTypeReference::GetCName(IAllocator* allocator)
 {
-    string result = string(&defaultAllocator);
+    const char *typeCName = this->lastType->GetCName(allocator);
+    usize typeLength = strlen(typeCName);
+    usize constLength = this->isConst ? 6 : 0;
+
+    string result = string(allocator);
+    result.length = constLength + typeLength + this->pointerCount + 1;
+    result.buffer = (char*)allocator->Allocate(result.length);
     if (this->isConst)
     {
-        result.Append("const ");
+        memcpy(result.buffer, "const ", constLength);
     }
-    result.AppendDeinit(this->lastType->GetCName(&defaultAllocator));
+    memcpy(result.buffer + constLength, typeCName, typeLength);
     for (i32 i = 0; i < this->pointerCount; i++)
     {
-        result.Append("*");
+        result.buffer[constLength + typeLength + i] = '*';
     }
-    return result.CloneDeinit(allocator);
+    result.buffer[result.length - 1] = '\0';
+    return result;
 }
 
 LinxcExpressionData::LinxcExpressionData()
@@ -0,0 +1,180 @@
+#include <builtins.hpp>
+#include <string.h>
+
+static LinxcType NewPrimitiveType(LinxcPrimitiveID ID, const char *name)
+{
+    LinxcType result = LinxcType();
+    //primitive names are never freed, so they can point straight at the string literal
+    result.name.allocator = NULL;
+    result.name.buffer = (char*)name;
+    result.name.length = strlen(name) + 1;
+    result.primitiveID = ID;
+    result.ID = (u32)ID + 1;
+    result.cName = name;
+    result.fullName = name;
+    return result;
+}
+
+LinxcType LinxcPrimitiveTypes[LinxcPrimitive_Count] = {
+    NewPrimitiveType(LinxcPrimitive_u8, "u8"),
+    NewPrimitiveType(LinxcPrimitive_u16, "u16"),
+    NewPrimitiveType(LinxcPrimitive_u32, "u32"),
+    NewPrimitiveType(LinxcPrimitive_u64, "u64"),
+    NewPrimitiveType(LinxcPrimitive_i8, "i8"),
+    NewPrimitiveType(LinxcPrimitive_i16, "i16"),
+    NewPrimitiveType(LinxcPrimitive_i32, "i32"),
+    NewPrimitiveType(LinxcPrimitive_i64, "i64"),
+    NewPrimitiveType(LinxcPrimitive_float, "float"),
+    NewPrimitiveType(LinxcPrimitive_double, "double"),
+    NewPrimitiveType(LinxcPrimitive_char, "char"),
+    NewPrimitiveType(LinxcPrimitive_void, "void"),
+    NewPrimitiveType(LinxcPrimitive_bool, "bool")
+};
+
+//all integer types cast to all other integer types, implicitly if casting up to the same sign
+//integers cast to float and double implicitly
+//float and double cast explicitly to all integer types and each other
+#define B(name) (1 << LinxcPrimitive_##name)
+#define UNSIGNED (B(u8) | B(u16) | B(u32) | B(u64))
+#define SIGNED (B(i8) | B(i16) | B(i32) | B(i64))
+#define FLOATING (B(float) | B(double))
+const u16 LinxcImplicitCasts[LinxcPrimitive_Count] = {
+    B(u16) | B(u32) | B(u64) | FLOATING, //u8
+    B(u32) | B(u64) | FLOATING, //u16
+    B(u64) | FLOATING, //u32
+    FLOATING, //u64
+    B(i16) | B(i32) | B(i64) | FLOATING, //i8
+    B(i32) | B(i64) | FLOATING, //i16
+    B(i64) | FLOATING, //i32
+    FLOATING, //i64
+    0, //float
+    0, //double
+    0, //char
+    0, //void
+    0 //bool
+};
+const u16 LinxcExplicitCasts[LinxcPrimitive_Count] = {
+    (UNSIGNED | SIGNED | FLOATING) & ~B(u8), //u8
+    (UNSIGNED | SIGNED | FLOATING) & ~B(u16), //u16
+    (UNSIGNED | SIGNED | FLOATING) & ~B(u32), //u32
+    (UNSIGNED | SIGNED | FLOATING) & ~B(u64), //u64
+    (UNSIGNED | SIGNED | FLOATING) & ~B(i8), //i8
+    (UNSIGNED | SIGNED | FLOATING) & ~B(i16), //i16
+    (UNSIGNED | SIGNED | FLOATING) & ~B(i32), //i32
+    (UNSIGNED | SIGNED | FLOATING) & ~B(i64), //i64
+    UNSIGNED | SIGNED | B(double), //float
+    UNSIGNED | SIGNED | B(float), //double
+    0, //char
+    0, //void
+    0 //bool
+};
+#undef B
+#undef UNSIGNED
+#undef SIGNED
+#undef FLOATING
+
+//when both operands have the same sign, the larger type is the result
+//when signed op unsigned, the signed operand is converted to unsigned first
+//float op double = double
+#define P(name) LinxcPrimitive_##name
+const LinxcPrimitiveID LinxcBuiltinArithmetic[LinxcPrimitive_char][LinxcPrimitive_char] = {
+    {P(u8), P(u16), P(u32), P(u64), P(u8), P(u16), P(u32), P(u64), P(float), P(double)}, //u8
+    {P(u16), P(u16), P(u32), P(u64), P(u16), P(u16), P(u32), P(u64), P(float), P(double)}, //u16
+    {P(u32), P(u32), P(u32), P(u64), P(u32), P(u32), P(u32), P(u64), P(float), P(double)}, //u32
+    {P(u64), P(u64), P(u64), P(u64), P(u64), P(u64), P(u64), P(u64), P(float), P(double)}, //u64
+    {P(u8), P(u16), P(u32), P(u64), P(i8), P(i16), P(i32), P(i64), P(float), P(double)}, //i8
+    {P(u16), P(u16), P(u32), P(u64), P(i16), P(i16), P(i32), P(i64), P(float), P(double)}, //i16
+    {P(u32), P(u32), P(u32), P(u64), P(i32), P(i32), P(i32), P(i64), P(float), P(double)}, //i32
+    {P(u64), P(u64), P(u64), P(u64), P(i64), P(i64), P(i64), P(i64), P(float), P(double)}, //i64
+    {P(float), P(float), P(float), P(float), P(float), P(float), P(float), P(float), P(float), P(double)}, //float
+    {P(double), P(double), P(double), P(double), P(double), P(double), P(double), P(double), P(double), P(double)}  //double
+};
+#undef P
+
+struct LinxcAttributeName
+{
+    const char *name;
+    usize length;
+    LinxcAttribute attribute;
+};
+static const LinxcAttributeName attributeNames[] = {
+    {"noalias", 7, LinxcAttribute_NoAlias},
+    {"keep", 4, LinxcAttribute_Keep},
+    {"reorder", 7, LinxcAttribute_Reorder},
+    {"soa", 3, LinxcAttribute_SoA}
+};
+
+LinxcAttribute LinxcAttributeFromName(const char *name, usize length)
+{
+    for (usize i = 0; i < sizeof(attributeNames) / sizeof(attributeNames[0]); i++)
+    {
+        if (attributeNames[i].length == length && memcmp(attributeNames[i].name, name, length) == 0)
+        {
+            return attributeNames[i].attribute;
+        }
+    }
+    return LinxcAttribute_None;
+}
+
+LinxcPrimitiveID LinxcPrimitiveFromToken(LinxcTokenID ID)
+{
+    switch (ID)
+    {
+        case Linxc_Keyword_u8:
+            return LinxcPrimitive_u8;
+        case Linxc_Keyword_u16:
+            return LinxcPrimitive_u16;
+        case Linxc_Keyword_u32:
+            return LinxcPrimitive_u32;
+        case Linxc_Keyword_u64:
+            return LinxcPrimitive_u64;
+        case Linxc_Keyword_i8:
+            return LinxcPrimitive_i8;
+        case Linxc_Keyword_i16:
+            return LinxcPrimitive_i16;
+        case Linxc_Keyword_i32:
+            return LinxcPrimitive_i32;
+        case Linxc_Keyword_i64:
+            return LinxcPrimitive_i64;
+        case Linxc_Keyword_float:
+            return LinxcPrimitive_float;
+        case Linxc_Keyword_double:
+            return LinxcPrimitive_double;
+        case Linxc_Keyword_char:
+            return LinxcPrimitive_char;
+        case Linxc_Keyword_void:
+            return LinxcPrimitive_void;
+        case Linxc_Keyword_bool:
+            return LinxcPrimitive_bool;
+        default:
+            return LinxcPrimitive_None;
+    }
+}
+LinxcPrimitiveID LinxcBuiltinOperatorResult(LinxcOperatorSlot slot, LinxcPrimitiveID myType, LinxcPrimitiveID otherType)
+{
+    bool bothNumeric = myType < LinxcPrimitive_char && otherType < LinxcPrimitive_char;
+    switch (slot)
+    {
+        case LinxcOperatorSlot_Equal:
+            //numeric types can only be set to values of the exact same type, anything else goes through a cast
+            return bothNumeric && myType == otherType ? myType : LinxcPrimitive_None;
+        case LinxcOperatorSlot_Plus:
+        case LinxcOperatorSlot_Minus:
+        case LinxcOperatorSlot_Asterisk:
+        case LinxcOperatorSlot_Slash:
+            return bothNumeric ? LinxcBuiltinArithmetic[myType][otherType] : LinxcPrimitive_None;
+        case LinxcOperatorSlot_EqualEqual:
+        case LinxcOperatorSlot_BangEqual:
+            //== and != MUST result in bool
+            if (bothNumeric || (myType == LinxcPrimitive_bool && otherType == LinxcPrimitive_bool))
+            {
+                return LinxcPrimitive_bool;
+            }
+            return LinxcPrimitive_None;
+        case LinxcOperatorSlot_AmpersandAmpersand:
+        case LinxcOperatorSlot_PipePipe:
+            return myType == LinxcPrimitive_bool && otherType == LinxcPrimitive_bool ? LinxcPrimitive_bool : LinxcPrimitive_None;
+        default:
+            return LinxcPrimitive_None;
+    }
+}
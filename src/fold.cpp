@@ -0,0 +1,627 @@
+#include <fold.hpp>
+#include <builtins.hpp>
+#include <layout.hpp>
+#include <hashmap.linxc>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <math.h>
+
+static bool LinxcIsIntegerPrimitive(LinxcPrimitiveID type)
+{
+    return type >= LinxcPrimitive_u8 && type <= LinxcPrimitive_i64;
+}
+static bool LinxcIsFoldablePrimitive(LinxcPrimitiveID type)
+{
+    return (type >= LinxcPrimitive_u8 && type <= LinxcPrimitive_double) || type == LinxcPrimitive_bool;
+}
+static u32 LinxcIntegerBits(LinxcPrimitiveID type)
+{
+    switch (type)
+    {
+        case LinxcPrimitive_u8:
+        case LinxcPrimitive_i8:
+            return 8;
+        case LinxcPrimitive_u16:
+        case LinxcPrimitive_i16:
+            return 16;
+        case LinxcPrimitive_u32:
+        case LinxcPrimitive_i32:
+            return 32;
+        default:
+            return 64;
+    }
+}
+//Truncates raw to the width of integer type and sign or zero extends it back to 64 bits
+static i64 LinxcWrapInteger(u64 raw, LinxcPrimitiveID type)
+{
+    u32 bits = LinxcIntegerBits(type);
+    if (bits == 64)
+    {
+        return (i64)raw;
+    }
+    u64 mask = ((u64)1 << bits) - 1;
+    raw &= mask;
+    if (type >= LinxcPrimitive_i8 && (raw >> (bits - 1)) != 0)
+    {
+        raw |= ~mask;
+    }
+    return (i64)raw;
+}
+//Returns the type C promotes a value of type to before doing arithmetic on it: int for anything narrower
+static LinxcPrimitiveID LinxcPromotedType(LinxcPrimitiveID type)
+{
+    if (type == LinxcPrimitive_bool || (LinxcIsIntegerPrimitive(type) && LinxcIntegerBits(type) < 32))
+    {
+        return LinxcPrimitive_i32;
+    }
+    return type;
+}
+//Returns the type C performs arithmetic between a and b in, after promoting both and converting them to a common type
+static LinxcPrimitiveID LinxcCArithmeticType(LinxcPrimitiveID a, LinxcPrimitiveID b)
+{
+    if (a == LinxcPrimitive_double || b == LinxcPrimitive_double)
+    {
+        return LinxcPrimitive_double;
+    }
+    if (a == LinxcPrimitive_float || b == LinxcPrimitive_float)
+    {
+        return LinxcPrimitive_float;
+    }
+    a = LinxcPromotedType(a);
+    b = LinxcPromotedType(b);
+    if (LinxcIntegerBits(a) != LinxcIntegerBits(b))
+    {
+        return LinxcIntegerBits(a) > LinxcIntegerBits(b) ? a : b;
+    }
+    return a <= LinxcPrimitive_u64 ? a : b;
+}
+static LinxcConstant LinxcNewConstant(LinxcPrimitiveID type)
+{
+    LinxcConstant result;
+    result.type = type;
+    result.integer = 0;
+    result.real = 0.0;
+    return result;
+}
+
+option<LinxcConstant> LinxcConstantFromLiteral(LinxcExpression *literal)
+{
+    if (literal->ID != LinxcExpr_Literal || literal->resolvesTo.lastType == NULL || literal->resolvesTo.pointerCount != 0)
+    {
+        return option<LinxcConstant>();
+    }
+    LinxcPrimitiveID type = literal->resolvesTo.lastType->primitiveID;
+    const char *text = literal->data.literal.buffer;
+    if (!LinxcIsFoldablePrimitive(type) || text == NULL || text[0] == '\'')
+    {
+        return option<LinxcConstant>();
+    }
+    LinxcConstant result = LinxcNewConstant(type);
+    if (type == LinxcPrimitive_bool)
+    {
+        if (strcmp(text, "true") == 0)
+        {
+            result.integer = 1;
+        }
+        else if (strcmp(text, "false") != 0)
+        {
+            return option<LinxcConstant>();
+        }
+        return option<LinxcConstant>(result);
+    }
+
+    //negative literals we produced are parenthesized
+    bool parenthesized = text[0] == '(';
+    if (parenthesized)
+    {
+        text++;
+    }
+    //anything left over after the number other than a suffix (eg: digit separators) is not ours to interpret
+    char *end = NULL;
+    if (type == LinxcPrimitive_float || type == LinxcPrimitive_double)
+    {
+        result.real = strtod(text, &end);
+        if (type == LinxcPrimitive_float)
+        {
+            result.real = (float)result.real;
+        }
+    }
+    else
+    {
+        errno = 0;
+        u64 raw = strtoull(text, &end, 0);
+        if (errno != 0)
+        {
+            return option<LinxcConstant>();
+        }
+        result.integer = LinxcWrapInteger(raw, type);
+        //an integer literal too large for its type is widened by C, leave it be
+        if ((u64)result.integer != raw)
+        {
+            return option<LinxcConstant>();
+        }
+    }
+    while (*end == 'f' || *end == 'F' || *end == 'u' || *end == 'U' || *end == 'l' || *end == 'L')
+    {
+        end++;
+    }
+    if (parenthesized)
+    {
+        if (*end != ')')
+        {
+            return option<LinxcConstant>();
+        }
+        end++;
+    }
+    if (end == text || *end != '\0')
+    {
+        return option<LinxcConstant>();
+    }
+    return option<LinxcConstant>(result);
+}
+
+option<LinxcConstant> LinxcConvertConstant(LinxcConstant value, LinxcPrimitiveID type)
+{
+    if (!LinxcIsFoldablePrimitive(type))
+    {
+        return option<LinxcConstant>();
+    }
+    LinxcConstant result = LinxcNewConstant(type);
+    bool fromReal = value.type == LinxcPrimitive_float || value.type == LinxcPrimitive_double;
+    if (type == LinxcPrimitive_bool)
+    {
+        result.integer = fromReal ? value.real != 0.0 : value.integer != 0;
+    }
+    else if (type == LinxcPrimitive_float || type == LinxcPrimitive_double)
+    {
+        if (fromReal)
+        {
+            result.real = value.real;
+        }
+        else result.real = value.type == LinxcPrimitive_u64 ? (double)(u64)value.integer : (double)value.integer;
+        if (type == LinxcPrimitive_float)
+        {
+            result.real = (float)result.real;
+        }
+    }
+    else if (fromReal)
+    {
+        //float to integer truncates, and is undefined if the truncated value does not fit
+        double truncated = trunc(value.real);
+        bool isUnsigned = type <= LinxcPrimitive_u64;
+        u32 bits = LinxcIntegerBits(type);
+        double min = isUnsigned ? 0.0 : -ldexp(1.0, bits - 1);
+        double max = isUnsigned ? ldexp(1.0, bits) : ldexp(1.0, bits - 1);
+        if (!(truncated >= min && truncated < max))
+        {
+            return option<LinxcConstant>();
+        }
+        result.integer = isUnsigned ? LinxcWrapInteger((u64)truncated, type) : (i64)truncated;
+    }
+    else result.integer = LinxcWrapInteger((u64)value.integer, type);
+    return option<LinxcConstant>(result);
+}
+
+option<LinxcExpression> LinxcLiteralFromConstant(IAllocator *allocator, LinxcConstant value)
+{
+    char buffer[64];
+    LinxcPrimitiveID type = value.type;
+    if (type == LinxcPrimitive_bool)
+    {
+        snprintf(buffer, sizeof(buffer), "%s", value.integer != 0 ? "true" : "false");
+    }
+    else if (type == LinxcPrimitive_float || type == LinxcPrimitive_double)
+    {
+        if (isnan(value.real) || isinf(value.real))
+        {
+            return option<LinxcExpression>();
+        }
+        //9 and 17 significant digits round trip floats and doubles exactly
+        i32 length = snprintf(buffer, sizeof(buffer) - 3, type == LinxcPrimitive_float ? "%.9g" : "%.17g", value.real);
+        if (strchr(buffer, '.') == NULL && strchr(buffer, 'e') == NULL)
+        {
+            buffer[length] = '.';
+            buffer[length + 1] = '0';
+            length += 2;
+            buffer[length] = '\0';
+        }
+        if (type == LinxcPrimitive_float)
+        {
+            buffer[length] = 'f';
+            buffer[length + 1] = '\0';
+        }
+    }
+    else if (type <= LinxcPrimitive_u64)
+    {
+        //suffixes keep the literal the same C type as the expression it replaces
+        const char *suffix = type == LinxcPrimitive_u64 ? "ULL" : type == LinxcPrimitive_u32 ? "U" : "";
+        snprintf(buffer, sizeof(buffer), "%llu%s", (unsigned long long)(u64)value.integer, suffix);
+    }
+    else
+    {
+        //the most negative i64 can't be written as a single literal
+        if (value.integer == (i64)((u64)1 << 63))
+        {
+            return option<LinxcExpression>();
+        }
+        const char *suffix = type == LinxcPrimitive_i64 ? "LL" : "";
+        //negative literals are parenthesized so that -(-1) doesn't transpile to --1
+        snprintf(buffer, sizeof(buffer), value.integer < 0 ? "(%lld%s)" : "%lld%s", (long long)value.integer, suffix);
+    }
+
+    LinxcExpression result;
+    result.ID = LinxcExpr_Literal;
+    result.data.literal = string(allocator, buffer);
+    result.resolvesTo = LinxcTypeReference(LinxcGetPrimitiveType(type));
+    return option<LinxcExpression>(result);
+}
+
+//Evaluates left op right the way the transpiled C would, producing a value of resultType.
+//Fails if C computes it in a type the literal for resultType would not have, or to a value resultType cannot hold,
+//as replacing the expression would then change what whatever contains it computes
+static option<LinxcConstant> LinxcEvaluateOperator(LinxcTokenID op, LinxcConstant left, LinxcConstant right, LinxcPrimitiveID resultType)
+{
+    LinxcOperatorSlot slot = LinxcGetOperatorSlot(op);
+    if (slot == LinxcOperatorSlot_AmpersandAmpersand || slot == LinxcOperatorSlot_PipePipe)
+    {
+        LinxcConstant result = LinxcNewConstant(LinxcPrimitive_bool);
+        result.integer = slot == LinxcOperatorSlot_AmpersandAmpersand ? (left.integer != 0 && right.integer != 0) : (left.integer != 0 || right.integer != 0);
+        return option<LinxcConstant>(result);
+    }
+
+    //C promotes anything narrower than int to int first, so eg: (u8)255 + (u8)1 is 256, not 0
+    LinxcPrimitiveID operandType = left.type == LinxcPrimitive_bool && right.type == LinxcPrimitive_bool ? LinxcPrimitive_bool : LinxcCArithmeticType(left.type, right.type);
+    bool isComparison = slot == LinxcOperatorSlot_EqualEqual || slot == LinxcOperatorSlot_BangEqual;
+    if (!isComparison && LinxcPromotedType(resultType) != operandType)
+    {
+        return option<LinxcConstant>();
+    }
+    option<LinxcConstant> leftOpt = LinxcConvertConstant(left, operandType);
+    option<LinxcConstant> rightOpt = LinxcConvertConstant(right, operandType);
+    if (!leftOpt.present || !rightOpt.present)
+    {
+        return option<LinxcConstant>();
+    }
+    left = leftOpt.value;
+    right = rightOpt.value;
+    bool isReal = operandType == LinxcPrimitive_float || operandType == LinxcPrimitive_double;
+
+    LinxcConstant result = LinxcNewConstant(resultType);
+    switch (slot)
+    {
+        case LinxcOperatorSlot_EqualEqual:
+        case LinxcOperatorSlot_BangEqual:
+        {
+            bool equal = isReal ? left.real == right.real : left.integer == right.integer;
+            result.integer = (slot == LinxcOperatorSlot_EqualEqual) == equal;
+            return option<LinxcConstant>(result);
+        }
+        case LinxcOperatorSlot_Plus:
+        case LinxcOperatorSlot_Minus:
+        case LinxcOperatorSlot_Asterisk:
+        case LinxcOperatorSlot_Slash:
+            break;
+        default:
+            return option<LinxcConstant>();
+    }
+
+    if (isReal)
+    {
+        //computing in double and rounding once gives the correctly rounded float result for these operators
+        double a = left.real;
+        double b = right.real;
+        result.real = slot == LinxcOperatorSlot_Plus ? a + b : slot == LinxcOperatorSlot_Minus ? a - b : slot == LinxcOperatorSlot_Asterisk ? a * b : a / b;
+        if (resultType == LinxcPrimitive_float)
+        {
+            result.real = (float)result.real;
+        }
+        return option<LinxcConstant>(result);
+    }
+
+    u64 a = (u64)left.integer;
+    u64 b = (u64)right.integer;
+    u64 raw;
+    if (slot == LinxcOperatorSlot_Slash)
+    {
+        if (b == 0)
+        {
+            return option<LinxcConstant>();
+        }
+        if (operandType <= LinxcPrimitive_u64)
+        {
+            raw = a / b;
+        }
+        else
+        {
+            //the one signed division that overflows
+            if (right.integer == -1 && LinxcWrapInteger(a, operandType) == LinxcWrapInteger((u64)1 << (LinxcIntegerBits(operandType) - 1), operandType))
+            {
+                return option<LinxcConstant>();
+            }
+            raw = (u64)(left.integer / right.integer);
+        }
+    }
+    else raw = slot == LinxcOperatorSlot_Plus ? a + b : slot == LinxcOperatorSlot_Minus ? a - b : a * b;
+    i64 value = LinxcWrapInteger(raw, operandType);
+    result.integer = LinxcWrapInteger((u64)value, resultType);
+    if (result.integer != value)
+    {
+        return option<LinxcConstant>();
+    }
+    return option<LinxcConstant>(result);
+}
+
+struct LinxcFoldState
+{
+    IAllocator *allocator;
+    /// const variables of foldable primitive types with initializers, which may be replaced by their value.
+    /// Maps to whether the variable's initializer has been folded yet
+    collections::hashmap<LinxcVar*, bool, collections::PointerKeys> constants;
+};
+
+static void LinxcFoldExpr(LinxcFoldState *state, LinxcExpression *expr);
+
+static void LinxcReplaceWithConstant(LinxcFoldState *state, LinxcExpression *expr, option<LinxcConstant> value)
+{
+    if (!value.present)
+    {
+        return;
+    }
+    option<LinxcExpression> literal = LinxcLiteralFromConstant(state->allocator, value.value);
+    if (literal.present)
+    {
+        *expr = literal.value;
+    }
+}
+static void LinxcFoldExpr(LinxcFoldState *state, LinxcExpression *expr)
+{
+    switch (expr->ID)
+    {
+    case LinxcExpr_Variable:
+    {
+        LinxcVar *var = expr->data.variable;
+        bool *folded = state->constants.Get(var);
+        if (folded != NULL)
+        {
+            //fold the initializer first, in case it refers to other constants
+            if (!*folded)
+            {
+                *folded = true;
+                LinxcFoldExpr(state, &var->defaultValue.value);
+            }
+            option<LinxcConstant> value = LinxcConstantFromLiteral(&var->defaultValue.value);
+            if (value.present)
+            {
+                LinxcReplaceWithConstant(state, expr, LinxcConvertConstant(value.value, var->type.AsTypeReference().value.lastType->primitiveID));
+            }
+        }
+    }
+    break;
+    case LinxcExpr_Modified:
+    {
+        LinxcModifiedExpression *modified = expr->data.modifiedExpression;
+        //&constant must keep referring to the variable
+        if (modified->modification == Linxc_Ampersand)
+        {
+            break;
+        }
+        LinxcFoldExpr(state, &modified->expression);
+        option<LinxcConstant> value = LinxcConstantFromLiteral(&modified->expression);
+        if (!value.present || expr->resolvesTo.lastType == NULL || expr->resolvesTo.pointerCount != 0)
+        {
+            break;
+        }
+        LinxcConstant result = value.value;
+        bool isReal = result.type == LinxcPrimitive_float || result.type == LinxcPrimitive_double;
+        //as with binary operators, C negates and complements anything narrower than int as an int
+        LinxcPrimitiveID promoted = LinxcPromotedType(result.type);
+        i64 promotedValue;
+        if (modified->modification == Linxc_Minus && result.type != LinxcPrimitive_bool)
+        {
+            if (isReal)
+            {
+                result.real = -result.real;
+            }
+            else
+            {
+                promotedValue = LinxcWrapInteger(0 - (u64)result.integer, promoted);
+                result.integer = LinxcWrapInteger((u64)promotedValue, result.type);
+                if (result.integer != promotedValue)
+                {
+                    break;
+                }
+            }
+        }
+        else if (modified->modification == Linxc_Bang && result.type == LinxcPrimitive_bool)
+        {
+            result.integer = result.integer == 0;
+        }
+        else if (modified->modification == Linxc_Tilde && LinxcIsIntegerPrimitive(result.type))
+        {
+            promotedValue = LinxcWrapInteger(~(u64)result.integer, promoted);
+            result.integer = LinxcWrapInteger((u64)promotedValue, result.type);
+            if (result.integer != promotedValue)
+            {
+                break;
+            }
+        }
+        else break;
+        LinxcReplaceWithConstant(state, expr, option<LinxcConstant>(result));
+    }
+    break;
+    case LinxcExpr_TypeCast:
+    {
+        LinxcFoldExpr(state, &expr->data.typeCast->expressionToCast);
+        option<LinxcConstant> value = LinxcConstantFromLiteral(&expr->data.typeCast->expressionToCast);
+        if (value.present && expr->resolvesTo.lastType != NULL && expr->resolvesTo.pointerCount == 0)
+        {
+            LinxcReplaceWithConstant(state, expr, LinxcConvertConstant(value.value, expr->resolvesTo.lastType->primitiveID));
+        }
+    }
+    break;
+    case LinxcExpr_Sizeof:
+    {
+        //pointer sizes and the alignment of 8 byte primitives depend on the target, so structs holding either are left to the C compiler,
+        //as layouts are computed for layoutTarget rather than the target the output is compiled for
+        LinxcTypeReference *type = &expr->data.sizeofCall;
+        if (type->lastType != NULL && type->pointerCount == 0 && (type->lastType->primitiveID != LinxcPrimitive_None || LinxcLayoutIsPortable(type->lastType)))
+        {
+            LinxcConstant size = LinxcNewConstant(LinxcPrimitive_u64);
+            size.integer = (i64)(type->lastType->primitiveID != LinxcPrimitive_None ? LinxcPrimitiveSize(type->lastType->primitiveID) : type->lastType->size);
+            if (size.integer != 0)
+            {
+                LinxcReplaceWithConstant(state, expr, option<LinxcConstant>(size));
+            }
+        }
+    }
+    break;
+    case LinxcExpr_FuncCall:
+    {
+        for (usize i = 0; i < expr->data.functionCall.inputParams.length; i++)
+        {
+            LinxcFoldExpr(state, &expr->data.functionCall.inputParams.data[i]);
+        }
+    }
+    break;
+    case LinxcExpr_OperatorCall:
+    {
+        LinxcOperator *op = expr->data.operatorCall;
+        if (op->operatorType == Linxc_ColonColon || op->operatorType == Linxc_Period || op->operatorType == Linxc_Arrow)
+        {
+            //the right side is a member name, only the left side can hold constants
+            if (op->operatorType != Linxc_ColonColon)
+            {
+                LinxcFoldExpr(state, &op->leftExpr);
+            }
+            if (op->rightExpr.ID == LinxcExpr_FuncCall)
+            {
+                LinxcFoldExpr(state, &op->rightExpr);
+            }
+            break;
+        }
+        //the left side of an assignment is written, not read
+        if (op->operatorType != Linxc_Equal)
+        {
+            LinxcFoldExpr(state, &op->leftExpr);
+        }
+        LinxcFoldExpr(state, &op->rightExpr);
+
+        option<LinxcConstant> left = LinxcConstantFromLiteral(&op->leftExpr);
+        option<LinxcConstant> right = LinxcConstantFromLiteral(&op->rightExpr);
+        if (left.present && right.present && op->operatorType != Linxc_Equal && expr->resolvesTo.lastType != NULL && expr->resolvesTo.pointerCount == 0)
+        {
+            LinxcReplaceWithConstant(state, expr, LinxcEvaluateOperator(op->operatorType, left.value, right.value, expr->resolvesTo.lastType->primitiveID));
+        }
+    }
+    break;
+    default:
+        break;
+    }
+}
+
+static bool LinxcIsFoldableConstant(LinxcVar *var)
+{
+    if (!var->isConst || !var->defaultValue.present)
+    {
+        return false;
+    }
+    option<LinxcTypeReference> type = var->type.AsTypeReference();
+    return type.present && type.value.lastType != NULL && type.value.pointerCount == 0 && LinxcIsFoldablePrimitive(type.value.lastType->primitiveID);
+}
+static void LinxcFoldBody(LinxcFoldState *state, collections::vector<LinxcStatement> *body)
+{
+    for (usize i = 0; i < body->count; i++)
+    {
+        LinxcStatement *stmt = body->Get(i);
+        if (stmt->ID == LinxcStmt_Expr)
+        {
+            LinxcFoldExpr(state, &stmt->data.expression);
+        }
+        else if (stmt->ID == LinxcStmt_Return)
+        {
+            LinxcFoldExpr(state, &stmt->data.returnStatement);
+        }
+        else if (stmt->ID == LinxcStmt_VarDecl && stmt->data.varDeclaration->defaultValue.present)
+        {
+            LinxcFoldExpr(state, &stmt->data.varDeclaration->defaultValue.value);
+            if (LinxcIsFoldableConstant(stmt->data.varDeclaration))
+            {
+                state->constants.Add(stmt->data.varDeclaration, true);
+            }
+        }
+    }
+}
+static void LinxcFoldType(LinxcFoldState *state, LinxcType *type)
+{
+    for (usize i = 0; i < type->functions.count; i++)
+    {
+        LinxcFoldBody(state, &type->functions.Get(i)->body);
+    }
+    for (usize i = 0; i < type->operatorOverloads.entries.count; i++)
+    {
+        LinxcFoldBody(state, &type->operatorOverloads.entries.ptr[i].func->function.body);
+    }
+    for (usize i = 0; i < type->subTypes.count; i++)
+    {
+        LinxcFoldType(state, type->subTypes.Get(i));
+    }
+}
+//Registers every const global first, so that functions see them regardless of declaration order
+static void LinxcCollectConstants(LinxcFoldState *state, LinxcNamespace *nameSpace)
+{
+    LinxcSymbolTable *symbols = &nameSpace->symbols;
+    for (u32 i = 0; i < symbols->capacity; i++)
+    {
+        LinxcSymbol *symbol = &symbols->slots[i];
+        if (symbol->kind == LinxcSymbol_Var && LinxcIsFoldableConstant(symbol->data.variable))
+        {
+            state->constants.Add(symbol->data.variable, false);
+        }
+        else if (symbol->kind == LinxcSymbol_Namespace)
+        {
+            LinxcCollectConstants(state, symbol->data.namespaceRef);
+        }
+    }
+}
+static void LinxcFoldNamespace(LinxcFoldState *state, LinxcNamespace *nameSpace)
+{
+    LinxcSymbolTable *symbols = &nameSpace->symbols;
+    for (u32 i = 0; i < symbols->capacity; i++)
+    {
+        LinxcSymbol *symbol = &symbols->slots[i];
+        switch (symbol->kind)
+        {
+        case LinxcSymbol_Func:
+            LinxcFoldBody(state, &symbol->data.function->body);
+            break;
+        case LinxcSymbol_Var:
+            if (symbol->data.variable->defaultValue.present)
+            {
+                LinxcFoldExpr(state, &symbol->data.variable->defaultValue.value);
+            }
+            break;
+        case LinxcSymbol_Type:
+            LinxcFoldType(state, symbol->data.type);
+            break;
+        case LinxcSymbol_Namespace:
+            LinxcFoldNamespace(state, symbol->data.namespaceRef);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+void LinxcFoldConstants(IAllocator *allocator, LinxcNamespace *rootNamespace)
+{
+    LinxcFoldState state;
+    state.allocator = allocator;
+    state.constants = collections::hashmap<LinxcVar*, bool, collections::PointerKeys>(&defaultAllocator);
+
+    LinxcCollectConstants(&state, rootNamespace);
+    LinxcFoldNamespace(&state, rootNamespace);
+
+    state.constants.deinit();
+}
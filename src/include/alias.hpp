@@ -0,0 +1,17 @@
+#ifndef linxccalias
+#define linxccalias
+
+#include <Linxc.h>
+#include <ast.hpp>
+
+/// Conservative interprocedural alias analysis over every function declared under rootNamespace.
+/// Sets isRestrict on a pointer parameter if it carries the noalias attribute (itself or through its function), or if
+///  - its function only dereferences it (*p, p->member) and never copies, reassigns, compares or passes it on,
+///  - its function is file-local (see LinxcInferLinkage, which must run first), is called at least once and never has its address taken, and
+///  - every call passes it an argument provably distinct from every other pointer argument of that call, and from anything the callee
+///    can reach otherwise: the address of a different local variable of the caller whose address is never stored anywhere,
+///    or a different restrict parameter of the caller.
+/// A project without a Main is a library, whose functions may be called from C with aliasing pointers, so only noalias applies in it.
+void LinxcInferRestrict(LinxcNamespace *rootNamespace);
+
+#endif
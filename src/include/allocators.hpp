@@ -9,19 +9,39 @@
 def_delegate(allocFunc, void *, void *, usize);
 def_delegate(freeFunc, void, void *, void *);
 
+//defined here rather than in allocators.cpp so that the checks in IAllocator can inline them
+inline void *CAllocator_Allocate(void *, usize bytes)
+{
+    return malloc(bytes);
+}
+inline void CAllocator_Free(void *, void *ptr)
+{
+    free(ptr);
+}
+
 struct IAllocator
 {
     void* instance;
     allocFunc allocFunction;
     freeFunc freeFunction;
 
+    //nearly every allocator in the transpiler is defaultAllocator or backed by it, so calls to the C allocator
+    //are made directly where they can be inlined, and only other allocators are called through the delegates
     inline void *Allocate(usize bytes)
     {
+        if (allocFunction == &CAllocator_Allocate)
+        {
+            return CAllocator_Allocate(instance, bytes);
+        }
         return allocFunction(instance, bytes);
     }
     inline void Free(void **ptr)
     {
-        freeFunction(instance, *ptr);
+        if (freeFunction == &CAllocator_Free)
+        {
+            CAllocator_Free(instance, *ptr);
+        }
+        else freeFunction(instance, *ptr);
         *ptr = NULL;
     }
 
@@ -31,7 +51,4 @@ struct IAllocator
 
 extern IAllocator defaultAllocator;
 
-void *CAllocator_Allocate(void *instance, usize bytes);
-void CAllocator_Free(void *instance, void *ptr);
-
 #endif
\ No newline at end of file
@@ -21,6 +21,79 @@ typedef struct LinxcTypeReference LinxcTypeReference;
 typedef struct LinxcOperatorImpl LinxcOperatorImpl;
 typedef struct LinxcOperatorFunc LinxcOperatorFunc;
 typedef struct LinxcTypeCast LinxcTypeCast;
+typedef struct LinxcTypeTable LinxcTypeTable;
+typedef struct LinxcOperatorIndex LinxcOperatorIndex;
+
+/// Builtin attributes, written as bare names before a declaration (eg: noalias float *data).
+/// Each one is also defined as an empty macro in Linxc.h, so attributed linxcstd code still compiles as C++.
+enum LinxcAttribute
+{
+    LinxcAttribute_None = 0,
+    /// On a pointer parameter, asserts that it aliases no other pointer used by the function. On a function, applies to all of its pointer parameters.
+    LinxcAttribute_NoAlias = 1 << 0,
+    /// On a function or type, keeps it in the output even if nothing reachable from Main uses it.
+    LinxcAttribute_Keep = 1 << 1,
+    /// On a type, lets the transpiler reorder its member variables to minimize padding.
+    LinxcAttribute_Reorder = 1 << 2,
+    /// On a type, generates a struct-of-arrays container for it alongside, see LinxcParser::TranspileSoA.
+    LinxcAttribute_SoA = 1 << 3
+};
+
+/// Index of each primitive type within the builtin operator and cast tables.
+/// Unsigned integers come before signed integers, mirroring LinxcTokenID.
+enum LinxcPrimitiveID
+{
+    LinxcPrimitive_None = -1,
+    LinxcPrimitive_u8,
+    LinxcPrimitive_u16,
+    LinxcPrimitive_u32,
+    LinxcPrimitive_u64,
+    LinxcPrimitive_i8,
+    LinxcPrimitive_i16,
+    LinxcPrimitive_i32,
+    LinxcPrimitive_i64,
+    LinxcPrimitive_float,
+    LinxcPrimitive_double,
+    LinxcPrimitive_char,
+    LinxcPrimitive_void,
+    LinxcPrimitive_bool,
+    LinxcPrimitive_Count
+};
+
+/// Dense index of the operators that primitive types support.
+enum LinxcOperatorSlot
+{
+    LinxcOperatorSlot_None = -1,
+    LinxcOperatorSlot_Equal,
+    LinxcOperatorSlot_Plus,
+    LinxcOperatorSlot_Minus,
+    LinxcOperatorSlot_Asterisk,
+    LinxcOperatorSlot_Slash,
+    LinxcOperatorSlot_EqualEqual,
+    LinxcOperatorSlot_BangEqual,
+    LinxcOperatorSlot_AmpersandAmpersand,
+    LinxcOperatorSlot_PipePipe,
+    LinxcOperatorSlot_Count
+};
+LinxcOperatorSlot LinxcGetOperatorSlot(LinxcTokenID op);
+
+struct LinxcOperatorEntry
+{
+    u64 key;
+    LinxcOperatorFunc *func;
+};
+/// A compact map of a user type's operator overloads, sorted by key so it can be binary searched.
+/// Keys are produced by LinxcOperatorImplKey. Casts are kept separately in LinxcOperatorIndex.
+struct LinxcOperatorOverloads
+{
+    collections::vector<LinxcOperatorEntry> entries;
+
+    LinxcOperatorOverloads();
+    LinxcOperatorOverloads(IAllocator *allocator);
+
+    void Add(u64 key, LinxcOperatorFunc *func);
+    LinxcOperatorFunc *Get(u64 key);
+};
 
 struct LinxcFunctionCall
 {
@@ -31,6 +104,36 @@ struct LinxcFunctionCall
     string ToString(IAllocator *allocator);
 };
 
+//types with at most this many members are searched linearly instead of through a LinxcMemberIndex
+#define LINXC_MEMBER_INDEX_THRESHOLD 8
+
+enum LinxcMemberKind
+{
+    LinxcMember_None,
+    LinxcMember_Var,
+    LinxcMember_Func,
+    LinxcMember_Type
+};
+struct LinxcMemberSlot
+{
+    u32 hash;
+    u32 index;
+    LinxcMemberKind kind;
+};
+/// Lazily built open-addressing index over a type's variables, functions and subtypes.
+/// Slots store indices into the member vectors rather than pointers, so growing them does not invalidate it.
+/// Members are only ever appended, so the index is stale whenever the member counts differ from the ones it was built with.
+struct LinxcMemberIndex
+{
+    LinxcMemberSlot *slots;
+    usize capacity;
+    usize variablesCount;
+    usize functionsCount;
+    usize subTypesCount;
+
+    LinxcMemberIndex();
+};
+
 /// Represents a type (struct) in Linxc.
 struct LinxcType
 {
@@ -42,7 +145,42 @@ struct LinxcType
     collections::vector<LinxcFunc> functions;
     collections::vector<LinxcType> subTypes;
     collections::vector<string> templateArgs;
-    collections::hashmap<LinxcOperatorImpl, LinxcOperatorFunc> operatorOverloads;
+    /// The types standing in for each of templateArgs within the body of a template, indexed like it.
+    collections::Array<LinxcType> templateParams;
+    /// Index of the template argument this type stands in for if it is one of a template's templateParams, -1 otherwise.
+    i32 templateParamIndex;
+    /// The template this type is a specialization of, see LinxcTemplateInstances. NULL if it is not one.
+    LinxcType *templateOf;
+    /// The arguments templateOf was specialized with, indexed like its templateArgs.
+    collections::Array<LinxcTypeReference> instanceArgs;
+    /// Whether the type depends on the arguments of a template: a template itself, one of its templateParams
+    /// or a specialization with such an argument. Dependent types are never transpiled.
+    bool isDependent;
+    /// Operators defined on this type. Always empty for primitive types, whose operators live in the builtin tables.
+    LinxcOperatorOverloads operatorOverloads;
+    /// The type's index within the builtin tables if it is a primitive type, LinxcPrimitive_None otherwise.
+    LinxcPrimitiveID primitiveID;
+    /// Unique ID of this type as handed out by the parser's LinxcTypeTable. 0 if unregistered.
+    u32 ID;
+    /// Only built once the type has more than LINXC_MEMBER_INDEX_THRESHOLD members, smaller types are scanned linearly.
+    LinxcMemberIndex memberIndex;
+    /// Cached results of GetCName and GetFullName, NULL until first requested.
+    const char *cName;
+    const char *fullName;
+    /// LinxcAttribute flags written before the struct.
+    u32 attributes;
+    /// Whether the type is used by anything reachable from the program's roots. Unreachable types are not transpiled.
+    bool isReachable;
+    /// Layout in C, filled in by LinxcComputeLayouts. size is 0 if the layout is unknown.
+    usize size;
+    usize alignment;
+    /// Bytes lost to padding between and after members.
+    usize padding;
+    /// Byte offset of each member variable, indexed like variables. Empty if the layout is unknown.
+    collections::Array<usize> offsets;
+    /// Indices into variables in the order members are emitted in C. Empty if they are emitted in declaration order.
+    collections::Array<u32> fieldOrder;
+    bool layoutComputed;
 
     LinxcType();
     LinxcType(IAllocator *allocator, string name, LinxcNamespace *myNamespace, LinxcType *myParent);
@@ -50,9 +188,14 @@ struct LinxcType
     LinxcType *FindSubtype(string name);
     LinxcFunc *FindFunction(string name);
     LinxcVar *FindVar(string name);
+    //Returns the index of the member of the given kind within its vector, or -1 if there is none
+    i64 FindMember(string name, LinxcMemberKind kind);
+    void RebuildMemberIndex();
 
-    string GetFullName(IAllocator *allocator);
-    string GetCName(IAllocator* allocator);
+    //Returns the namespace-qualified name (eg: namespace::type). Built with allocator on the first call and cached after
+    const char *GetFullName(IAllocator *allocator);
+    //Returns the name of the type in C (eg: namespace_type). Built with allocator on the first call and cached after
+    const char *GetCName(IAllocator* allocator);
 
     LinxcExpression AsExpression();
 };
@@ -65,6 +208,11 @@ struct LinxcTypeReference
 
     collections::Array<LinxcTypeReference> templateArgs;
 
+    /// Interned ID of (lastType, templateArgs) within the LinxcTypeTable. 0 if lastType is NULL.
+    /// Two references to the same type with the same template arguments always share the same ID,
+    /// so comparing references never has to walk templateArgs.
+    u32 ID;
+
     u32 pointerCount;
 
     bool isConst;
@@ -72,26 +220,19 @@ struct LinxcTypeReference
     LinxcTypeReference();
     LinxcTypeReference(LinxcType *type);
     string ToString(IAllocator *allocator);
+    //Returns whether the referenced type depends on the arguments of a template, in which case its operators and casts are only known once specialized
+    inline bool IsDependent()
+    {
+        return this->lastType != NULL && this->lastType->isDependent;
+    }
     string GetCName(IAllocator* allocator);
 
-    bool CanCastTo(LinxcTypeReference type, bool implicitly);
+    bool CanCastTo(LinxcTypeReference type, bool implicitly, LinxcOperatorIndex *index);
     //dont need to check const as only const u8* is a special type
     //we parse that within EvaluatePossible
-    bool operator==(LinxcTypeReference B)
+    inline bool operator==(LinxcTypeReference B)
     {
-        bool templatesEqual = true;
-        if (this->templateArgs.length != B.templateArgs.length)
-        {
-            templatesEqual = false;
-        }
-        if (templatesEqual)
-        {
-            for (usize i = 0; i < this->templateArgs.length; i++)
-            {
-                templatesEqual = this->templateArgs.data[i] == B.templateArgs.data[i];
-            }
-        }
-        return this->lastType == B.lastType && templatesEqual && this->pointerCount == B.pointerCount;
+        return this->ID == B.ID && this->pointerCount == B.pointerCount;
     }
     inline bool operator!=(LinxcTypeReference B)
     {
@@ -100,6 +241,47 @@ struct LinxcTypeReference
 };
 u32 LinxcTypeReferenceHash(LinxcTypeReference A);
 
+/// Key of a template specialization within LinxcTypeTable.
+/// Template args are stored as their interned ID in the low 32 bits and pointer count in the high 32 bits.
+struct LinxcTypeSpecialization
+{
+    u32 typeID;
+    collections::Array<u64> templateArgs;
+};
+u32 LinxcTypeSpecializationHash(LinxcTypeSpecialization A);
+bool LinxcTypeSpecializationEql(LinxcTypeSpecialization A, LinxcTypeSpecialization B);
+/// Key traits of LinxcTypeTable::specializations, which is only probed from ast.cpp where both functions can be inlined.
+struct LinxcTypeSpecializationKeys
+{
+    template <typename HashFunc>
+    static inline u32 Hash(HashFunc, LinxcTypeSpecialization key)
+    {
+        return LinxcTypeSpecializationHash(key);
+    }
+    template <typename EqlFunc>
+    static inline bool Eql(EqlFunc, LinxcTypeSpecialization A, LinxcTypeSpecialization B)
+    {
+        return LinxcTypeSpecializationEql(A, B);
+    }
+};
+
+/// Hands out unique IDs to types and hash-conses type references, such that every distinct
+/// (type, template args) pair has exactly one ID. Pointer count and constness are kept on the
+/// LinxcTypeReference itself as the parser modifies them in place.
+struct LinxcTypeTable
+{
+    IAllocator *allocator;
+    u32 nextID;
+    collections::hashmap<LinxcTypeSpecialization, u32, LinxcTypeSpecializationKeys> specializations;
+
+    LinxcTypeTable();
+    LinxcTypeTable(IAllocator *allocator);
+
+    u32 NewTypeID();
+    //Sets reference->ID to the interned ID of it's lastType and templateArgs, returning the ID
+    u32 Intern(LinxcTypeReference *reference);
+};
+
 enum LinxcExpressionID
 {
     LinxcExpr_None,
@@ -171,10 +353,21 @@ struct LinxcFunc
     collections::Array<LinxcVar> arguments;
     u16 necessaryArguments;
     collections::Array<string> templateArgs;
+    /// Cached result of GetCName, NULL until first requested.
+    const char *cName;
+    /// LinxcAttribute flags written before the function.
+    u32 attributes;
+    /// Whether the function is reachable from the program's roots. Unreachable functions are not transpiled.
+    bool isReachable;
+    /// Set by the linkage inference when nothing outside the defining file refers to the function, transpiled static and left out of the header.
+    bool isFileLocal;
+    /// Set by LinxcLowerLargeStructs when the function writes its large struct result through a pointer passed before its arguments instead of returning it.
+    bool returnsThroughPointer;
 
     LinxcFunc();
     LinxcFunc(string name, LinxcExpression returnType);
-    string GetCName(IAllocator* allocator);
+    //Returns the name of the function in C. Built with allocator on the first call and cached after
+    const char *GetCName(IAllocator* allocator);
 };
 
 /// Represents a variable in Linxc, including it's type, name and optionally default value.
@@ -185,6 +378,14 @@ struct LinxcVar
     string name;
     option<LinxcExpression> defaultValue;
     bool isConst;
+    /// LinxcAttribute flags written before the variable.
+    u32 attributes;
+    /// Set by the alias analysis on pointer parameters proven not to alias, transpiled as restrict.
+    bool isRestrict;
+    /// Set by the linkage inference on global variables nothing outside the defining file refers to, transpiled static and left out of the header.
+    bool isFileLocal;
+    /// Set by LinxcLowerLargeStructs on large struct parameters passed as a const pointer to the caller's argument instead of by value.
+    bool isPassedByPointer;
 
     LinxcVar();
     LinxcVar(string varName, LinxcExpression varType, option<LinxcExpression> defaultVal);
@@ -200,17 +401,71 @@ struct LinxcMacro
     collections::vector<LinxcToken> body;
 };
 
+/// Kinds of entities a namespace can hold. When one name refers to several kinds,
+/// lookups prefer the lowest value, matching the order ParseIdentifier used to check them in.
+enum LinxcSymbolKind
+{
+    LinxcSymbol_None,
+    LinxcSymbol_Func,
+    LinxcSymbol_Var,
+    LinxcSymbol_Type,
+    LinxcSymbol_Namespace
+};
+union LinxcSymbolData
+{
+    LinxcFunc *function;
+    LinxcVar *variable;
+    LinxcType *type;
+    LinxcNamespace *namespaceRef;
+};
+struct LinxcSymbol
+{
+    u32 hash;
+    LinxcSymbolKind kind;
+    LinxcSymbolData data;
+
+    string *GetName();
+};
+/// Open-addressing table of every entity declared directly in a namespace.
+/// Allocates nothing until the first symbol is added, so empty namespaces are nearly free.
+struct LinxcSymbolTable
+{
+    IAllocator *allocator;
+    LinxcSymbol *slots;
+    u32 capacity;
+    u32 count;
+
+    LinxcSymbolTable();
+    LinxcSymbolTable(IAllocator *allocator);
+
+    //Adds a symbol, replacing any symbol of the same kind and name
+    void Add(LinxcSymbolKind kind, LinxcSymbolData data);
+    //Returns the highest priority symbol with the given name, or NULL if there is none
+    LinxcSymbol *Find(string name);
+    //Returns the symbol with the given name and kind, or NULL if there is none
+    LinxcSymbol *Find(string name, LinxcSymbolKind kind);
+};
+
 struct LinxcNamespace
 {
     LinxcNamespace *parentNamespace;
     string name;
-    collections::hashmap<string, LinxcVar> variables;
-    collections::hashmap<string, LinxcFunc> functions;
-    collections::hashmap<string, LinxcType> types;
-    collections::hashmap<string, LinxcNamespace> subNamespaces; //dont need pointer here as internal is pointer already
+    /// Variables, functions, types and subnamespaces declared in this namespace.
+    /// Each entity is allocated individually so pointers to it remain valid as the namespace grows.
+    LinxcSymbolTable symbols;
 
     LinxcNamespace();
     LinxcNamespace(IAllocator *allocator, string name);
+
+    LinxcVar *AddVar(LinxcVar var);
+    LinxcFunc *AddFunction(LinxcFunc func);
+    LinxcType *AddType(LinxcType type);
+    LinxcNamespace *AddNamespace(LinxcNamespace subNamespace);
+
+    LinxcVar *FindVar(string name);
+    LinxcFunc *FindFunction(string name);
+    LinxcType *FindType(string name);
+    LinxcNamespace *FindNamespace(string name);
 };
 struct LinxcNamespaceScope
 {
@@ -263,8 +518,10 @@ struct LinxcOperator
     LinxcExpression leftExpr;
     LinxcExpression rightExpr;
     LinxcTokenID operatorType;
+    /// The user defined overload the operation calls, set by EvaluatePossible. NULL for builtin operators.
+    LinxcOperatorFunc *overload;
 
-    option<LinxcTypeReference> EvaluatePossible();
+    option<LinxcTypeReference> EvaluatePossible(LinxcOperatorIndex *index);
 };
 
 struct LinxcIncludeStatement
@@ -325,8 +582,9 @@ struct LinxcOperatorImpl
 
     string ToString(IAllocator* allocator);
 };
-u32 LinxcOperatorImplHash(LinxcOperatorImpl A);
-bool LinxcOperatorImplEql(LinxcOperatorImpl A, LinxcOperatorImpl B);
+//Packs everything that identifies an overload on it's owning type into a single integer:
+//the operator or cast kind, the pointer counts of both types and the interned ID of the other type
+u64 LinxcOperatorImplKey(LinxcOperatorImpl A);
 
 struct LinxcOperatorFunc
 {
@@ -335,4 +593,53 @@ struct LinxcOperatorFunc
 
     string ToString(IAllocator* allocator);
 };
+
+/// Key of a user defined cast within LinxcOperatorIndex.
+/// Each type is stored as its interned ID in the low 32 bits and pointer count in the high 32 bits.
+struct LinxcCastKey
+{
+    u64 fromType;
+    u64 toType;
+};
+u32 LinxcCastKeyHash(LinxcCastKey A);
+bool LinxcCastKeyEql(LinxcCastKey A, LinxcCastKey B);
+/// Key traits of LinxcOperatorIndex::userCasts, which is only probed from ast.cpp where both functions can be inlined.
+struct LinxcCastKeys
+{
+    template <typename HashFunc>
+    static inline u32 Hash(HashFunc, LinxcCastKey key)
+    {
+        return LinxcCastKeyHash(key);
+    }
+    template <typename EqlFunc>
+    static inline bool Eql(EqlFunc, LinxcCastKey A, LinxcCastKey B)
+    {
+        return LinxcCastKeyEql(A, B);
+    }
+};
+
+/// Resolves operators and casts to the type they result in.
+/// Operations between two non-pointer primitive types are answered from the static builtin tables,
+/// user defined operators are looked up in the LinxcOperatorOverloads of the user type involved
+/// and user defined casts by the interned IDs of both types.
+struct LinxcOperatorIndex
+{
+    collections::hashmap<LinxcCastKey, LinxcOperatorFunc*, LinxcCastKeys> userCasts;
+
+    //Allocates nothing until the first user defined cast is added
+    LinxcOperatorIndex();
+    void deinit();
+
+    //Adds a user defined overload to the index. func must outlive the index.
+    void Add(LinxcOperatorFunc *func);
+    //Looks up user defined overloads only, returns NULL for builtin operators
+    LinxcOperatorFunc *FindOperator(LinxcTypeReference myType, LinxcTokenID op, LinxcTypeReference otherType);
+    //Explicit lookups also return implicit casts, as all implicit casts may be used explicitly
+    LinxcOperatorFunc *FindCast(LinxcTypeReference myType, LinxcTypeReference toType, bool implicitly);
+    bool CanCast(LinxcTypeReference myType, LinxcTypeReference toType, bool implicitly);
+
+    //Writes the user defined overload the operation calls to overload if there is one, or NULL otherwise
+    option<LinxcTypeReference> ResolveOperator(LinxcTypeReference myType, LinxcTokenID op, LinxcTypeReference otherType, LinxcOperatorFunc **overload);
+    option<LinxcTypeReference> ResolveCast(LinxcTypeReference myType, LinxcTypeReference toType, bool implicitly);
+};
 #endif
\ No newline at end of file
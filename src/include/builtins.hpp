@@ -0,0 +1,43 @@
+#ifndef linxccbuiltins
+#define linxccbuiltins
+
+#include <Linxc.h>
+#include <lexer.hpp>
+#include <ast.hpp>
+
+/// The builtin environment shared by every parser: the primitive types and the operators and casts between them.
+/// Everything here lives in static storage, so constructing a LinxcParser does not allocate any of it.
+
+/// The primitive types, indexed by LinxcPrimitiveID. Their type IDs are 1 to LinxcPrimitive_Count.
+/// Their names point to static strings and must never be deinitialized.
+extern LinxcType LinxcPrimitiveTypes[LinxcPrimitive_Count];
+
+/// Bit j of row i is set if primitive type i implicitly casts to primitive type j.
+extern const u16 LinxcImplicitCasts[LinxcPrimitive_Count];
+
+/// Bit j of row i is set if primitive type i explicitly casts to primitive type j. Includes every implicit cast.
+extern const u16 LinxcExplicitCasts[LinxcPrimitive_Count];
+
+/// The result of +, -, * and / between two numeric types (u8 to double).
+extern const LinxcPrimitiveID LinxcBuiltinArithmetic[LinxcPrimitive_char][LinxcPrimitive_char];
+
+inline LinxcType *LinxcGetPrimitiveType(LinxcPrimitiveID ID)
+{
+    return &LinxcPrimitiveTypes[ID];
+}
+inline bool LinxcBuiltinCanCast(LinxcPrimitiveID fromType, LinxcPrimitiveID toType, bool implicitly)
+{
+    u16 row = implicitly ? LinxcImplicitCasts[fromType] : LinxcExplicitCasts[fromType];
+    return ((row >> toType) & 1) != 0;
+}
+
+//Returns the primitive type named by a keyword token, or LinxcPrimitive_None if the token does not name one
+LinxcPrimitiveID LinxcPrimitiveFromToken(LinxcTokenID ID);
+
+//Returns the builtin attribute with the given name, or LinxcAttribute_None if there is none
+LinxcAttribute LinxcAttributeFromName(const char *name, usize length);
+
+//Returns the type resulting from myType op otherType, or LinxcPrimitive_None if the builtin operator does not exist
+LinxcPrimitiveID LinxcBuiltinOperatorResult(LinxcOperatorSlot slot, LinxcPrimitiveID myType, LinxcPrimitiveID otherType);
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef linxccfold
+#define linxccfold
+
+#include <Linxc.h>
+#include <allocators.hpp>
+#include <ast.hpp>
+
+/// The value of a folded literal of a numeric or bool primitive type.
+/// Integers are kept sign or zero extended to 64 bits according to type, floats and doubles in real.
+struct LinxcConstant
+{
+    LinxcPrimitiveID type;
+    i64 integer;
+    double real;
+};
+
+//Parses a literal expression of a numeric or bool primitive type. Returns nothing for string and char literals
+option<LinxcConstant> LinxcConstantFromLiteral(LinxcExpression *literal);
+//Converts value to type with C cast semantics. Returns nothing if the result would be undefined, such as an out of range float to integer cast
+option<LinxcConstant> LinxcConvertConstant(LinxcConstant value, LinxcPrimitiveID type);
+//Returns the literal that transpiles to exactly value in C, or nothing if there is none (eg: for infinities)
+option<LinxcExpression> LinxcLiteralFromConstant(IAllocator *allocator, LinxcConstant value);
+
+/// Folds every builtin operator, unary operator and cast whose operands are literals into a single literal, along with sizeof
+/// of primitives and of types with a layout computed by LinxcComputeLayouts that is the same on every target, see LinxcLayoutIsPortable,
+/// and replaces uses of const primitive variables with literal initializers by their value.
+/// Values are computed the way the transpiled C computes them, integer promotions included. An operation whose C result
+/// its literal could not reproduce, such as (u8)255 + (u8)1, which is 256 in C, is left unfolded.
+/// Walks every function body and global initializer declared under rootNamespace, rewriting expressions in place.
+/// New literals are allocated with allocator.
+void LinxcFoldConstants(IAllocator *allocator, LinxcNamespace *rootNamespace);
+
+#endif
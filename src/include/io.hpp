@@ -9,6 +9,15 @@ namespace io
 {
     string ReadFile(const char *path);
 
+    //Writes length bytes of buffer to path in a single write, replacing the file if it exists
+    bool WriteFile(const char *path, const char *buffer, usize length);
+
+    //Returns true if the file at path exists and contains exactly length bytes of buffer. Streams the file in fixed chunks
+    bool FileContentsEqual(const char *path, const char *buffer, usize length);
+
+    //Like WriteFile, but leaves the file (and its modification time) untouched if it already holds exactly buffer
+    bool WriteFileIfChanged(const char *path, const char *buffer, usize length);
+
     bool FileExists(const char *path);
 
     collections::Array<string> GetFilesInDirectory(IAllocator *allocator, const char *dirPath);
@@ -0,0 +1,33 @@
+#ifndef linxcclayout
+#define linxcclayout
+
+#include <Linxc.h>
+#include <allocators.hpp>
+#include <ast.hpp>
+#include <writer.hpp>
+
+/// The parts of the C ABI struct layout depends on beyond the fixed primitive sizes.
+struct LinxcLayoutTarget
+{
+    usize pointerSize;
+    /// Alignment of 8 byte primitives within structs, which is 4 on 32-bit x86 and 8 nearly everywhere else.
+    usize wideAlignment;
+};
+
+//Returns the layout target of the machine linxcc was built for
+LinxcLayoutTarget LinxcHostLayoutTarget();
+//Returns the size in bytes of a primitive type in C, or 0 for void
+usize LinxcPrimitiveSize(LinxcPrimitiveID type);
+
+//Returns whether type is laid out the same for every target, which it is unless it holds a pointer or an 8 byte primitive at any depth
+bool LinxcLayoutIsPortable(LinxcType *type);
+
+/// Computes size, alignment, padding and member offsets for every struct declared under rootNamespace, as a C compiler for target would lay them out.
+/// Members of types with the reorder attribute are placed in order of decreasing alignment, which leaves no padding between them.
+/// Templates and types with members of unknown layout are left with a size of 0.
+void LinxcComputeLayouts(IAllocator *allocator, LinxcNamespace *rootNamespace, LinxcLayoutTarget target);
+/// Writes one line per struct with a computed layout, giving its size, alignment and wasted padding in bytes,
+/// along with the padding reordering its members would leave if it is not already reordered.
+void LinxcWriteLayoutReport(LinxcWriter *writer, LinxcNamespace *rootNamespace, LinxcLayoutTarget target, IAllocator *nameAllocator);
+
+#endif
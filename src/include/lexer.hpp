@@ -241,11 +241,10 @@ struct LinxcTokenizer
     usize lineStartIndex;
     usize currentToken;
 
-    collections::hashmap<string, LinxcTokenID>* nameToToken;
     collections::vector<LinxcToken> tokenStream;
 
     LinxcTokenizer();
-    LinxcTokenizer(const char *buffer, i32 bufferLength, collections::hashmap<string, LinxcTokenID>* nameToTokenRef);
+    LinxcTokenizer(const char *buffer, i32 bufferLength);
 
     LinxcToken TokenizeAdvance();
     inline LinxcToken Next()
@@ -272,7 +271,7 @@ bool LinxcIsPrimitiveType(LinxcTokenID ID);
 
 // LinxcToken LinxcTokenizerPeekNextUntilValid(LinxcTokenizer *self);
 
-LinxcTokenID LinxcGetKeyword(const char *str, usize strlen, bool isPreprocessorDirective, collections::hashmap<string, LinxcTokenID>* nameToToken);
+LinxcTokenID LinxcGetKeyword(const char *str, usize strlen, bool isPreprocessorDirective);
 
 
 #endif
\ No newline at end of file
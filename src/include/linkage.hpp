@@ -0,0 +1,14 @@
+#ifndef linxcclinkage
+#define linxcclinkage
+
+#include <Linxc.h>
+#include <ast.hpp>
+
+/// Sets isFileLocal on every free function and global variable defined by one of files that no other file refers to.
+/// Main, anything with the keep attribute and templates are never file-local, and neither is anything a header or another
+/// translation unit may refer to it from: the methods of templates, operator overloads, default arguments and global initializers.
+/// A program without a Main is a library, whose functions may all be called from outside the project, so nothing in it is file-local.
+/// files must hold every parsed file, as references from any other file go unseen.
+void LinxcInferLinkage(LinxcNamespace *rootNamespace, LinxcParsedFile **files, usize count);
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef linxcclowering
+#define linxcclowering
+
+#include <Linxc.h>
+#include <ast.hpp>
+
+/// Rewrites how structs larger than threshold bytes cross calls, wherever doing so cannot change what the program does.
+/// Only functions the linkage inference made file-local are lowered, so every exported signature stays as written.
+/// Sets isPassedByPointer on a struct parameter of such a function, which then takes a const pointer to its caller's argument, if
+///  - its function never assigns to it, takes its address or calls a method on it,
+///  - it has no default value, and
+///  - every call passes it a local variable or parameter of the caller whose address the caller never takes, which nothing else can modify during the call.
+/// Sets returnsThroughPointer on a free function returning such a struct, which then writes it to a pointer passed before its arguments,
+/// if every call is a statement of its own: initializing a non-const variable, assigned to something, returned or discarded.
+/// Functions that have their address taken keep their signatures too.
+/// Struct sizes come from LinxcComputeLayouts, structs of unknown size are never lowered.
+void LinxcLowerLargeStructs(LinxcNamespace *rootNamespace, usize threshold);
+
+//Returns the call expr makes, looking through scope resolution, if it calls a function that returns through a pointer. Returns NULL otherwise
+LinxcFunctionCall *LinxcCallReturningThroughPointer(LinxcExpression *expr);
+
+#endif
@@ -9,6 +9,10 @@
 #include <lexer.hpp>
 #include <array.linxc>
 #include <io.hpp>
+#include <writer.hpp>
+#include <reachability.hpp>
+#include <layout.hpp>
+#include <templates.hpp>
 
 typedef struct LinxcParserState LinxcParserState;
 typedef struct LinxcParser LinxcParser;
@@ -93,6 +97,41 @@ inline i32 GetPrecedence(LinxcTokenID ID)
             return -1;
     }
 };
+//Returns what the C name of an overload of a binary operator ends in, eg: Numerics_Vector2_operatorAdd.
+//Returns NULL for operators that may not be overloaded
+inline const char *GetOperatorFuncName(LinxcTokenID ID)
+{
+    switch (ID)
+    {
+        case Linxc_Plus:
+            return "Add";
+        case Linxc_Minus:
+            return "Subtract";
+        case Linxc_Asterisk:
+            return "Multiply";
+        case Linxc_Slash:
+            return "Divide";
+        case Linxc_Percent:
+            return "Modulo";
+        case Linxc_Ampersand:
+            return "BitAnd";
+        case Linxc_Pipe:
+            return "BitOr";
+        case Linxc_Caret:
+            return "BitXor";
+        case Linxc_EqualEqual:
+            return "Equals";
+        case Linxc_BangEqual:
+            return "NotEquals";
+        case Linxc_AngleBracketLeft:
+            return "LessThan";
+        case Linxc_AngleBracketRight:
+            return "GreaterThan";
+        //&& and || short circuit, which a function call cannot, and assignments stay plain copies
+        default:
+            return NULL;
+    }
+};
 inline option<bool> IsSigned(LinxcTokenID tokenID)
 {
     if (tokenID >= Linxc_Keyword_u8 && tokenID <= Linxc_Keyword_u64)
@@ -144,8 +183,10 @@ struct LinxcParserState
     LinxcFunc *currentFunction;
     bool isToplevel;
     LinxcEndOn endOn;
-    collections::hashmap<string, LinxcVar *> varsInScope;
+    collections::hashmap<string, LinxcVar *, StringKeys> varsInScope;
     bool parsingLinxci;
+    /// The number of enclosing template argument lists whose closing > was already consumed as part of a >> token.
+    u32 pendingTemplateCloses;
 
     void deinit();
     LinxcParserState(LinxcParser *myParser, LinxcParsedFile *currentFile, LinxcTokenizer *myTokenizer, LinxcEndOn endOn, bool isTopLevel, bool isParsingLinxci);
@@ -162,12 +203,33 @@ struct LinxcParser
     ///The actual .linxc files to be included in the compilation.
     collections::vector<string> includedFiles;
     /// Maps includeName to parsed file and data.
-    collections::hashset<string> parsingFiles;
-    collections::hashmap<string, LinxcParsedFile> parsedFiles;
-    collections::hashmap<string, LinxcTokenID> nameToToken;
+    collections::hashset<string, StringKeys> parsingFiles;
+    collections::hashmap<string, LinxcParsedFile, StringKeys> parsedFiles;
     LinxcType* typeofU8;
     LinxcNamespace globalNamespace;
+    LinxcTypeTable typeTable;
+    /// Resolves operators and casts, builtin ones through the static tables in builtins.hpp
+    LinxcOperatorIndex operatorIndex;
     string thisKeyword;
+    /// The number of threads used to transpile. 0 uses every hardware thread, 1 transpiles serially on the calling thread.
+    u32 transpileThreads;
+    /// Whether the whole-program passes run by PrepareTranspile are up to date with the parsed files.
+    bool preparedForTranspile;
+    /// Whether to only transpile the functions and types reachable from Main, see LinxcEliminateUnreachable. Off by default.
+    bool eliminateUnreachable;
+    /// What the last PrepareTranspile eliminated, if eliminateUnreachable is set.
+    LinxcEliminationReport eliminated;
+    /// The ABI struct layouts are computed for. Defaults to the host's.
+    LinxcLayoutTarget layoutTarget;
+    /// Whether PrepareTranspile writes the size, alignment and padding of every struct to layoutReport, see LinxcWriteLayoutReport. Off by default.
+    bool reportLayouts;
+    /// The layouts computed by the last PrepareTranspile, if reportLayouts is set.
+    LinxcWriter layoutReport;
+    /// Structs larger than this many bytes are passed and returned through pointers by file-local functions, where that cannot be observed, see LinxcLowerLargeStructs.
+    /// Defaults to 64, 0 turns the lowering off.
+    usize largeStructThreshold;
+    /// Every template specialization referenced by the parsed files, see TranspileInstantiations.
+    LinxcTemplateInstances templateInstances;
 
     LinxcParser(IAllocator *allocator);
 
@@ -184,6 +246,9 @@ struct LinxcParser
     LinxcExpression ParseExpression(LinxcParserState *state, LinxcExpression primary, i32 startingPrecedence);
     // parses a single identifier and returns either a func reference, type reference or variable reference. searches for references within the provided parentScopeOverride if any, if not, takes the values from all current namespace scopes in state and using namespace; declarations as well.
     option<LinxcExpression> ParseIdentifier(LinxcParserState *state, option<LinxcExpression> parentScopeOverride);
+    //Call after parsing the name of a template when the next token is <, ends after parsing the closing >.
+    //Returns a reference to the specialization named by the type arguments in between, instantiating it if this is its first reference
+    option<LinxcTypeReference> ParseTemplateSpecialization(LinxcParserState *state, LinxcType *templateType);
 
     void deinit();
     void AddAllFilesFromDirectory(string directoryPath);
@@ -198,22 +263,91 @@ struct LinxcParser
         {
             return variableType.pointerCount == 1 && exprResult.pointerCount == 1 && variableType.isConst;
         }
-        else if (variableType == exprResult || exprResult.CanCastTo(variableType, true))
+        //whether a template parameter converts is only known once the template is specialized, where C checks it instead
+        else if (variableType.IsDependent() || exprResult.IsDependent())
+        {
+            return true;
+        }
+        else if (variableType == exprResult || exprResult.CanCastTo(variableType, true, &this->operatorIndex))
         {
             return true;
         }
 
         return false;
     }
-    LinxcOperatorFunc NewDefaultCast(LinxcType** primitiveTypePtrs, i32 myTypeIndex, i32 otherTypeIndex, bool isImplicit);
-    LinxcOperatorFunc NewDefaultOperator(LinxcType** primitiveTypePtrs, i32 myTypeIndex, i32 otherTypeIndex, LinxcTokenID op);
 
+    //Transpiles parsedFile and writes the results to the given paths
     void TranspileFile(LinxcParsedFile *parsedFile, const char* outputPathC, const char* outputPathH);
-    void TranspileStatementH(FILE* fs, LinxcStatement* stmt);
-    void TranspileFunc(FILE* fs, LinxcFunc* func);
-    void TranspileVar(FILE* fs, LinxcVar* var);
-    void TranspileExpr(FILE* fs, LinxcExpression* expr);
-    void TranspileStatementC(FILE* fs, LinxcStatement* stmt);
+    //Transpiles parsedFile into memory, appending the source and header to writerC and writerH
+    void TranspileFile(LinxcParsedFile *parsedFile, LinxcWriter* writerC, LinxcWriter* writerH);
+    //Transpiles every file in parsedFiles into memory, appending the source and header of parsedFiles[i] to writersC[i] and writersH[i].
+    //Output is identical regardless of transpileThreads
+    void TranspileFiles(LinxcParsedFile **parsedFiles, usize count, LinxcWriter* writersC, LinxcWriter* writersH);
+    //Transpiles parsedFiles and every .linxc file they include as a single project into outputDirectory.
+    //With one shard, writes a self-contained projectName.c. Otherwise writes projectName.h and projectName0.c to projectName{shardCount - 1}.c
+    void TranspileAmalgamated(LinxcParsedFile **parsedFiles, usize count, const char* outputDirectory, const char* projectName, usize shardCount);
+    //Transpiles parsedFiles and every .linxc file they include into memory as a single project.
+    //Declarations come first, with each C header included once and files ordered after the files they include.
+    //Function definitions are split across shardCount writers in contiguous runs of roughly equal size.
+    //If writerH is NULL, the declarations are prepended to every shard. Otherwise they go to writerH, which each shard includes as headerName
+    void TranspileAmalgamated(LinxcParsedFile **parsedFiles, usize count, const char* headerName, LinxcWriter* writerH, LinxcWriter* writersC, usize shardCount);
+    //Writes outputDirectory/prefixName.h, a prefix header including every C header used by parsedFiles and the .linxc files they include,
+    //along with the gcc/clang response files prefixName.build.rsp, which precompiles it, and prefixName.use.rsp, which compiles a generated source against it
+    void TranspilePrefixHeader(LinxcParsedFile **parsedFiles, usize count, const char* outputDirectory, const char* prefixName);
+    //Transpiles the prefix header of parsedFiles into memory
+    void TranspilePrefixHeader(LinxcWriter* writer, LinxcParsedFile **parsedFiles, usize count);
+    //Runs the whole-program analyses over everything parsed so far, if not already run since the last file was parsed
+    void PrepareTranspile();
+    //Computes and caches the C name of every type and function, so that transpiling never allocates from this->allocator
+    void CacheNames(LinxcNamespace *namespaceToCache);
+    void CacheNames(LinxcType *type);
+    //Transpiles the header of file. .linxc includes whose types the header only uses by pointer or in
+    //function declarations are replaced by forward declarations of those types
+    void TranspileHeader(LinxcWriter* writer, LinxcParsedFile* file);
+    //Transpiles the includes that file's header forward declared instead, as its source needs the full definitions
+    void TranspileSourceIncludes(LinxcWriter* writer, LinxcParsedFile* file);
+    //Transpiles what the header of file leaves out for being file-local: its file-local globals and the prototypes of its
+    //file-local functions. If isStatic, they are declared static and the globals defined. Otherwise the globals are only declared extern,
+    //to be defined by TranspileGlobalDefinitions. See LinxcInferLinkage
+    void TranspileFileLocals(LinxcWriter* writer, LinxcParsedFile* file, bool isStatic);
+    //Transpiles the definitions of the globals of file that headers declare extern, along with its file-local ones if includeFileLocals.
+    //Every global has to be defined by exactly one source
+    void TranspileGlobalDefinitions(LinxcWriter* writer, LinxcParsedFile* file, bool includeFileLocals);
+    //Returns whether file's header must keep includeStmt as a full #include
+    bool HeaderNeedsFullInclude(LinxcParsedFile* file, LinxcStatement* includeStmt);
+    //Returns the parsed file an include statement refers to, or NULL if it has not been parsed
+    LinxcParsedFile *FindIncludedFile(LinxcStatement* includeStmt);
+    void TranspileStatementH(LinxcWriter* writer, LinxcStatement* stmt);
+    //Transpiles the struct typedef of type, followed by its struct-of-arrays container if any and its method prototypes
+    void TranspileType(LinxcWriter* writer, LinxcType* type);
+    //Transpiles stmt as TranspileStatementH does, preceded by the declarations of every template specialization
+    //it uses that is not yet in emitted. Each is guarded by LINXC_INSTANCE_ and its C name, so that it is declared once
+    //per translation unit however many headers use it
+    void TranspileDeclarationH(LinxcWriter* writer, LinxcStatement* stmt, LinxcInstanceUses* emitted);
+    //Writes the method definitions of every template specialization used by parsedFiles and the .linxc files they include to outputPath
+    void TranspileInstantiations(LinxcParsedFile **parsedFiles, usize count, const char* outputPath);
+    //Transpiles the method definitions of every template specialization used by parsedFiles and the .linxc files they include into a
+    //single source, which includes the header of each of those files. Per-file sources never define them, so that every specialization
+    //is compiled exactly once for the entire project
+    void TranspileInstantiations(LinxcWriter* writer, LinxcParsedFile **parsedFiles, usize count);
+    //Transpiles the struct-of-arrays container of a type with the soa attribute: a struct named after the type with an SoA suffix,
+    //holding an array per member variable, with static inline Init, Reserve, Add, Get, Set and Deinit functions that allocate through
+    //the LinxcAllocFunc and LinxcFreeFunc passed to Init, or call malloc and free directly if those are NULL. Every name it generates besides the member arrays, such as linxcCount, starts with linxc
+    //so as not to collide with them
+    void TranspileSoA(LinxcWriter* writer, LinxcType* type);
+    void TranspileFunc(LinxcWriter* writer, LinxcFunc* func);
+    //Transpiles the definition of an operator overload as a static inline function taking both operands by value,
+    //with this pointing to the copy of the left one
+    void TranspileOperatorFunc(LinxcWriter* writer, LinxcOperatorFunc* operatorFunc);
+    //Transpiles a call to func, passing thisExpr (or this, if thisExpr is NULL) first if func is a method.
+    //thisExpr is passed by address unless thisIsPointer. resultPointer, if not NULL, is passed before everything else
+    //to a function that returns through a pointer, see LinxcLowerLargeStructs
+    void TranspileFunctionCall(LinxcWriter* writer, LinxcFunctionCall* call, LinxcExpression* thisExpr, bool thisIsPointer, const char* resultPointer);
+    void TranspileTypeReference(LinxcWriter* writer, LinxcTypeReference* typeRef);
+    void TranspileVar(LinxcWriter* writer, LinxcVar* var);
+    void TranspileExpr(LinxcWriter* writer, LinxcExpression* expr);
+    //Transpiles a statement in the body of func
+    void TranspileStatementC(LinxcWriter* writer, LinxcFunc* func, LinxcStatement* stmt);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,29 @@
+#ifndef linxccreachability
+#define linxccreachability
+
+#include <Linxc.h>
+#include <ast.hpp>
+#include <vector.linxc>
+#include <writer.hpp>
+
+/// The functions and types LinxcEliminateUnreachable found nothing to use, in namespace order.
+struct LinxcEliminationReport
+{
+    collections::vector<LinxcFunc*> funcs;
+    collections::vector<LinxcType*> types;
+
+    LinxcEliminationReport();
+    LinxcEliminationReport(IAllocator *allocator);
+    //Writes one line per eliminated function and type, with its namespace-qualified name
+    void Write(LinxcWriter *writer, IAllocator *nameAllocator);
+    void deinit();
+};
+
+/// Sets isReachable on every function and type declared under rootNamespace to whether the program can use it.
+/// The roots are the global Main function, every function and type with the keep attribute and every global variable.
+/// A program without a Main is a library, in which case every function is a root.
+/// From the roots, follows every function called or referenced, and every type named or held by value or pointer,
+/// including the member variables of reachable types. Unreachable functions and types are appended to report.
+void LinxcEliminateUnreachable(LinxcNamespace *rootNamespace, LinxcEliminationReport *report);
+
+#endif
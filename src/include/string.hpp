@@ -44,9 +44,44 @@ struct string
     bool operator!=(const char* other);
 };
 
-bool stringEql(string A, string B);
+inline bool stringEql(string A, string B)
+{
+    if (A.buffer == NULL && B.buffer == NULL)
+    {
+        return true;
+    }
+    return A.eql(B.buffer);
+}
+
+inline u32 stringHash(string A)
+{
+    if (A.buffer == NULL)
+    {
+        return 7;
+    }
+    u32 hash = 7;
+    for (usize i = 0; i < A.length - 1; i++)
+    {
+        hash = hash * 31 + A.buffer[i];
+    }
+
+    return hash;
+}
 
-u32 stringHash(string A);
+/// Key traits for hashmap and hashset that hash and compare strings by content with stringHash and stringEql, inlined.
+struct StringKeys
+{
+    template <typename HashFunc>
+    static inline u32 Hash(HashFunc, string key)
+    {
+        return stringHash(key);
+    }
+    template <typename EqlFunc>
+    static inline bool Eql(EqlFunc, string A, string B)
+    {
+        return stringEql(A, B);
+    }
+};
 
 u32 charHash(const char *A);
 
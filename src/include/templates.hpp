@@ -0,0 +1,52 @@
+#ifndef linxcctemplates
+#define linxcctemplates
+
+#include <Linxc.h>
+#include <allocators.hpp>
+#include <ast.hpp>
+#include <vector.linxc>
+#include <hashmap.linxc>
+
+/// Every specialization of every template in the project, each instantiated exactly once.
+/// Specializations are keyed by the interned ID of (template, arguments) within the LinxcTypeTable, which only
+/// considers the type and pointer count of each argument, so every file naming vector<i32> shares one LinxcType.
+/// Specializations without dependent arguments are registered in the namespace of their template as Name_Arg,
+/// so that every whole-program pass sees them alongside the types written out in source.
+struct LinxcTemplateInstances
+{
+    IAllocator *allocator;
+    collections::hashmap<u32, LinxcType*, collections::IntegerKeys> byID;
+    /// Specializations without dependent arguments, in the order they were first referenced in.
+    collections::vector<LinxcType*> concrete;
+    /// Specializations whose method bodies have yet to be cloned from their template.
+    collections::vector<LinxcType*> pending;
+    bool cloningBodies;
+
+    LinxcTemplateInstances();
+    LinxcTemplateInstances(IAllocator *allocator);
+
+    //Returns the specialization of templateType with args, instantiating it on the first reference to it anywhere in the project.
+    //Member variables and method signatures are substituted straight away, method bodies once no instantiation is in progress,
+    //so that specializations referring to each other can be resolved. Dependent specializations never get method bodies
+    LinxcType *Instantiate(LinxcTypeTable *typeTable, LinxcOperatorIndex *operatorIndex, LinxcType *templateType, collections::Array<LinxcTypeReference> args);
+    void deinit();
+};
+
+/// The specializations used by a set of declarations, ordered such that each one comes after the specializations
+/// its member variables and method signatures use.
+struct LinxcInstanceUses
+{
+    collections::vector<LinxcType*> instances;
+    /// Specializations used by one ordered before them, which only happens through pointers and needs a forward declaration.
+    collections::vector<LinxcType*> forwards;
+    collections::vector<LinxcType*> visiting;
+
+    LinxcInstanceUses(IAllocator *allocator);
+
+    //Appends the reachable specializations used by stmt, including in function bodies, that are not yet in instances
+    void Collect(LinxcStatement *stmt);
+    void Add(LinxcType *type);
+    void deinit();
+};
+
+#endif
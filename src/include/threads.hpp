@@ -0,0 +1,40 @@
+#ifndef linxccthreads
+#define linxccthreads
+
+#include <Linxc.h>
+
+#if WINDOWS
+#include <Windows.h>
+#endif
+#if POSIX
+#include <pthread.h>
+#endif
+
+def_delegate(LinxcThreadFunc, void, void*);
+
+/// A minimal wrapper over the platform's native threads.
+/// On platforms with neither WINDOWS nor POSIX defined, Start runs func immediately on the calling thread.
+struct LinxcThread
+{
+    #if WINDOWS
+    HANDLE handle;
+    #endif
+    #if POSIX
+    pthread_t handle;
+    #endif
+    LinxcThreadFunc func;
+    void *data;
+    bool started;
+
+    LinxcThread();
+
+    //Starts running func(data) on a new thread. Returns false if the thread could not be created,
+    //in which case func has been run on the calling thread instead
+    bool Start(LinxcThreadFunc func, void *data);
+    void Join();
+};
+
+//Returns the number of hardware threads available to the process, at least 1
+u32 LinxcHardwareThreadCount();
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef linxccwriter
+#define linxccwriter
+
+#include <Linxc.h>
+#include <allocators.hpp>
+#include <string.hpp>
+
+/// A growable in-memory output buffer for the transpiler.
+/// Appends never parse format strings; the result is written to disk with a single write per file,
+/// or can be read straight from buffer when transpiling into memory.
+struct LinxcWriter
+{
+    IAllocator *allocator;
+    char *buffer;
+    usize length;
+    usize capacity;
+
+    LinxcWriter();
+    LinxcWriter(IAllocator *allocator);
+    LinxcWriter(IAllocator *allocator, usize minCapacity);
+
+    void deinit();
+    void Clear();
+    void EnsureCapacity(usize minCapacity);
+
+    void Append(const char *text, usize textLength);
+    inline void Append(const char *text)
+    {
+        this->Append(text, strlen(text));
+    }
+    inline void Append(char character)
+    {
+        if (this->length + 1 > this->capacity)
+        {
+            this->EnsureCapacity(this->length + 1);
+        }
+        this->buffer[this->length] = character;
+        this->length += 1;
+    }
+
+    //Writes the buffer to a file in one go, skipping the write if the file already has the same contents
+    //so that build tools do not see a new modification time. Returns false if the file could not be written
+    bool WriteToFile(const char *path);
+};
+
+#endif
@@ -50,6 +50,59 @@ string io::ReadFile(const char *path)
     return result;
 }
 
+bool io::WriteFile(const char *path, const char *buffer, usize length)
+{
+    FILE *fs;
+    if (fopen_s(&fs, path, "w") != 0)
+    {
+        return false;
+    }
+    bool success = true;
+    if (length > 0)
+    {
+        success = fwrite(buffer, sizeof(char), length, fs) == length;
+    }
+    fclose(fs);
+    return success;
+}
+
+bool io::FileContentsEqual(const char *path, const char *buffer, usize length)
+{
+    FILE *fs;
+    if (fopen_s(&fs, path, "r") != 0)
+    {
+        return false;
+    }
+    //read in the same text mode WriteFile writes in, so line endings compare equal on every platform
+    char chunk[4096];
+    usize compared = 0;
+    bool equal = true;
+    while (equal)
+    {
+        usize read = fread(chunk, sizeof(char), sizeof(chunk), fs);
+        if (read == 0)
+        {
+            break;
+        }
+        if (compared + read > length || memcmp(chunk, buffer + compared, read) != 0)
+        {
+            equal = false;
+        }
+        compared += read;
+    }
+    fclose(fs);
+    return equal && compared == length;
+}
+
+bool io::WriteFileIfChanged(const char *path, const char *buffer, usize length)
+{
+    if (io::FileContentsEqual(path, buffer, length))
+    {
+        return true;
+    }
+    return io::WriteFile(path, buffer, length);
+}
+
 collections::Array<string> io::GetFilesInDirectory(IAllocator *allocator, const char *dirPath)
 {
     #if WINDOWS
@@ -0,0 +1,270 @@
+#include <layout.hpp>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+struct LinxcWideProbe
+{
+    char first;
+    i64 wide;
+};
+
+LinxcLayoutTarget LinxcHostLayoutTarget()
+{
+    LinxcLayoutTarget result;
+    result.pointerSize = sizeof(void*);
+    result.wideAlignment = offsetof(LinxcWideProbe, wide);
+    return result;
+}
+usize LinxcPrimitiveSize(LinxcPrimitiveID type)
+{
+    switch (type)
+    {
+        case LinxcPrimitive_u8:
+        case LinxcPrimitive_i8:
+        case LinxcPrimitive_char:
+        case LinxcPrimitive_bool:
+            return 1;
+        case LinxcPrimitive_u16:
+        case LinxcPrimitive_i16:
+            return 2;
+        case LinxcPrimitive_u32:
+        case LinxcPrimitive_i32:
+        case LinxcPrimitive_float:
+            return 4;
+        case LinxcPrimitive_u64:
+        case LinxcPrimitive_i64:
+        case LinxcPrimitive_double:
+            return 8;
+        default:
+            return 0;
+    }
+}
+
+bool LinxcLayoutIsPortable(LinxcType *type)
+{
+    if (type->primitiveID != LinxcPrimitive_None)
+    {
+        return LinxcPrimitiveSize(type->primitiveID) != 8;
+    }
+    for (usize i = 0; i < type->variables.count; i++)
+    {
+        option<LinxcTypeReference> typeRef = type->variables.Get(i)->type.AsTypeReference();
+        //a type holding itself by value has no computed layout, so this only recurses into types that do
+        if (!typeRef.present || typeRef.value.lastType == NULL || typeRef.value.pointerCount > 0 || !LinxcLayoutIsPortable(typeRef.value.lastType))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void LinxcComputeLayout(IAllocator *allocator, LinxcType *type, LinxcLayoutTarget target);
+
+//Gets the size and alignment of a member variable, computing the layout of its type if needed. Returns false if either is unknown
+static bool LinxcMemberLayout(IAllocator *allocator, LinxcVar *member, LinxcLayoutTarget target, usize *size, usize *alignment)
+{
+    option<LinxcTypeReference> typeRef = member->type.AsTypeReference();
+    if (!typeRef.present || typeRef.value.lastType == NULL)
+    {
+        return false;
+    }
+    if (typeRef.value.pointerCount > 0)
+    {
+        *size = target.pointerSize;
+        *alignment = target.pointerSize;
+    }
+    else if (typeRef.value.lastType->primitiveID != LinxcPrimitive_None)
+    {
+        *size = LinxcPrimitiveSize(typeRef.value.lastType->primitiveID);
+        *alignment = *size == 8 ? target.wideAlignment : *size;
+    }
+    else
+    {
+        //only the report passes NULL, by which point every layout is computed
+        if (allocator != NULL)
+        {
+            LinxcComputeLayout(allocator, typeRef.value.lastType, target);
+        }
+        *size = typeRef.value.lastType->size;
+        *alignment = typeRef.value.lastType->alignment;
+    }
+    return *size != 0;
+}
+
+//Places count members of the given sizes and alignments in order, returning the total padding and
+//writing the struct's size and alignment. Writes each member's offset to offsets if it is not NULL
+static usize LinxcLayMembers(usize *sizes, usize *alignments, u32 *order, usize count, usize *offsets, usize *size, usize *alignment)
+{
+    usize offset = 0;
+    usize padding = 0;
+    *alignment = 1;
+    for (usize i = 0; i < count; i++)
+    {
+        u32 member = order[i];
+        usize memberAlignment = alignments[member];
+        usize aligned = (offset + memberAlignment - 1) / memberAlignment * memberAlignment;
+        padding += aligned - offset;
+        if (offsets != NULL)
+        {
+            offsets[member] = aligned;
+        }
+        offset = aligned + sizes[member];
+        if (memberAlignment > *alignment)
+        {
+            *alignment = memberAlignment;
+        }
+    }
+    *size = (offset + *alignment - 1) / *alignment * *alignment;
+    padding += *size - offset;
+    return padding;
+}
+//Fills order with the member indices sorted by decreasing alignment, keeping declaration order between equals
+static void LinxcOrderByAlignment(usize *alignments, u32 *order, usize count)
+{
+    for (usize i = 0; i < count; i++)
+    {
+        u32 member = (u32)i;
+        usize j = i;
+        while (j > 0 && alignments[order[j - 1]] < alignments[member])
+        {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = member;
+    }
+}
+
+/// Sizes and alignments of every member of a type, along with an order to lay them out in.
+struct LinxcMemberLayouts
+{
+    usize *sizes;
+    usize *alignments;
+    u32 *order;
+    usize count;
+};
+//Gets the layouts of every member of type in declaration order. Returns false if any of them is unknown
+static bool LinxcGetMemberLayouts(IAllocator *allocator, LinxcType *type, LinxcLayoutTarget target, LinxcMemberLayouts *result)
+{
+    usize count = type->variables.count;
+    result->count = count;
+    result->sizes = (usize*)defaultAllocator.Allocate(sizeof(usize) * (count * 2 + 1));
+    result->alignments = result->sizes + count;
+    result->order = (u32*)defaultAllocator.Allocate(sizeof(u32) * (count + 1));
+    for (usize i = 0; i < count; i++)
+    {
+        result->order[i] = (u32)i;
+        if (!LinxcMemberLayout(allocator, type->variables.Get(i), target, &result->sizes[i], &result->alignments[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+static void LinxcFreeMemberLayouts(LinxcMemberLayouts *layouts)
+{
+    defaultAllocator.Free((void**)&layouts->sizes);
+    defaultAllocator.Free((void**)&layouts->order);
+}
+
+static void LinxcComputeLayout(IAllocator *allocator, LinxcType *type, LinxcLayoutTarget target)
+{
+    //marked up front, so that a type containing itself by value is left unknown rather than recursing forever
+    if (type->layoutComputed)
+    {
+        return;
+    }
+    type->layoutComputed = true;
+    //templates have no layout until they are instantiated, and C does not allow empty structs
+    if (type->templateArgs.count > 0 || type->variables.count == 0)
+    {
+        return;
+    }
+
+    LinxcMemberLayouts members;
+    if (LinxcGetMemberLayouts(allocator, type, target, &members))
+    {
+        if (type->attributes & LinxcAttribute_Reorder)
+        {
+            LinxcOrderByAlignment(members.alignments, members.order, members.count);
+            type->fieldOrder = collections::Array<u32>(allocator, (u32*)allocator->Allocate(sizeof(u32) * members.count), members.count);
+            memcpy(type->fieldOrder.data, members.order, sizeof(u32) * members.count);
+        }
+        type->offsets = collections::Array<usize>(allocator, (usize*)allocator->Allocate(sizeof(usize) * members.count), members.count);
+        type->padding = LinxcLayMembers(members.sizes, members.alignments, members.order, members.count, type->offsets.data, &type->size, &type->alignment);
+    }
+    LinxcFreeMemberLayouts(&members);
+}
+static void LinxcComputeLayoutsType(IAllocator *allocator, LinxcType *type, LinxcLayoutTarget target)
+{
+    LinxcComputeLayout(allocator, type, target);
+    for (usize i = 0; i < type->subTypes.count; i++)
+    {
+        LinxcComputeLayoutsType(allocator, type->subTypes.Get(i), target);
+    }
+}
+void LinxcComputeLayouts(IAllocator *allocator, LinxcNamespace *rootNamespace, LinxcLayoutTarget target)
+{
+    LinxcSymbolTable *symbols = &rootNamespace->symbols;
+    for (u32 i = 0; i < symbols->capacity; i++)
+    {
+        LinxcSymbol *symbol = &symbols->slots[i];
+        if (symbol->kind == LinxcSymbol_Type)
+        {
+            LinxcComputeLayoutsType(allocator, symbol->data.type, target);
+        }
+        else if (symbol->kind == LinxcSymbol_Namespace)
+        {
+            LinxcComputeLayouts(allocator, symbol->data.namespaceRef, target);
+        }
+    }
+}
+
+static void LinxcWriteLayoutReportType(LinxcWriter *writer, LinxcType *type, LinxcLayoutTarget target, IAllocator *nameAllocator)
+{
+    if (type->size != 0)
+    {
+        char line[160];
+        snprintf(line, sizeof(line), ": size %llu, alignment %llu, padding %llu", (unsigned long long)type->size, (unsigned long long)type->alignment, (unsigned long long)type->padding);
+        writer->Append("type ");
+        writer->Append(type->GetFullName(nameAllocator));
+        writer->Append(line);
+
+        if (type->fieldOrder.length == 0 && type->padding > 0)
+        {
+            LinxcMemberLayouts members;
+            LinxcGetMemberLayouts(NULL, type, target, &members);
+            LinxcOrderByAlignment(members.alignments, members.order, members.count);
+            usize size;
+            usize alignment;
+            usize reorderedPadding = LinxcLayMembers(members.sizes, members.alignments, members.order, members.count, NULL, &size, &alignment);
+            if (reorderedPadding < type->padding)
+            {
+                snprintf(line, sizeof(line), " (%llu if reordered)", (unsigned long long)reorderedPadding);
+                writer->Append(line);
+            }
+            LinxcFreeMemberLayouts(&members);
+        }
+        writer->Append('\n');
+    }
+    for (usize i = 0; i < type->subTypes.count; i++)
+    {
+        LinxcWriteLayoutReportType(writer, type->subTypes.Get(i), target, nameAllocator);
+    }
+}
+void LinxcWriteLayoutReport(LinxcWriter *writer, LinxcNamespace *rootNamespace, LinxcLayoutTarget target, IAllocator *nameAllocator)
+{
+    LinxcSymbolTable *symbols = &rootNamespace->symbols;
+    for (u32 i = 0; i < symbols->capacity; i++)
+    {
+        LinxcSymbol *symbol = &symbols->slots[i];
+        if (symbol->kind == LinxcSymbol_Type)
+        {
+            LinxcWriteLayoutReportType(writer, symbol->data.type, target, nameAllocator);
+        }
+        else if (symbol->kind == LinxcSymbol_Namespace)
+        {
+            LinxcWriteLayoutReport(writer, symbol->data.namespaceRef, target, nameAllocator);
+        }
+    }
+}
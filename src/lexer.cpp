@@ -601,7 +601,7 @@ LinxcToken LinxcTokenizer::TokenizeAdvance()
                 }
                 else
                 {
-                    result.ID = LinxcGetKeyword(self->buffer + result.start, self->index - result.start, self->prevTokenID == Linxc_Hash && !self->preprocessorDirective, self->nameToToken);
+                    result.ID = LinxcGetKeyword(self->buffer + result.start, self->index - result.start, self->prevTokenID == Linxc_Hash && !self->preprocessorDirective);
                     if (result.ID == Linxc_Invalid)
                     {
                         result.ID = Linxc_Identifier;
@@ -1250,12 +1250,11 @@ LinxcTokenizer::LinxcTokenizer()
     this->preprocessorDirective = false;
     this->prevIndex = 0;
     this->prevTokenID = Linxc_Invalid;
-    this->nameToToken = NULL;
     this->currentToken = 0;
     this->tokenStream = collections::vector<LinxcToken>();
 }
 
-LinxcTokenizer::LinxcTokenizer(const char *buffer, i32 bufferLength, collections::hashmap<string, LinxcTokenID>* nameToTokenRef)
+LinxcTokenizer::LinxcTokenizer(const char *buffer, i32 bufferLength)
 {
     this->buffer = buffer;
     this->bufferLength = bufferLength;
@@ -1265,30 +1264,116 @@ LinxcTokenizer::LinxcTokenizer(const char *buffer, i32 bufferLength, collections
     this->preprocessorDirective = false;
     this->prevIndex = 0;
     this->prevTokenID = Linxc_Invalid;
-    this->nameToToken = nameToTokenRef;
     this->currentToken = 0;
     this->tokenStream = collections::vector<LinxcToken>();
 };
 
-LinxcTokenID LinxcGetKeyword(const char *chars, usize strlen, bool isPreprocessorDirective, collections::hashmap<string, LinxcTokenID> *nameToToken)
+struct LinxcKeyword
 {
-    string str = string(chars, strlen);
-
-    LinxcTokenID *tokenIDPtr = nameToToken->Get(str);
-
-    str.deinit();
+    const char *name;
+    usize length;
+    LinxcTokenID ID;
+};
+//sorted by name so that LinxcGetKeyword can binary search it
+static const LinxcKeyword keywords[] = {
+    {"alignas", 7, Linxc_Keyword_alignas},
+    {"alignof", 7, Linxc_Keyword_alignof},
+    {"atomic", 6, Linxc_Keyword_atomic},
+    {"attribute", 9, Linxc_keyword_attribute},
+    {"auto", 4, Linxc_Keyword_auto},
+    {"bool", 4, Linxc_Keyword_bool},
+    {"break", 5, Linxc_Keyword_break},
+    {"case", 4, Linxc_Keyword_case},
+    {"char", 4, Linxc_Keyword_char},
+    {"complex", 7, Linxc_Keyword_complex},
+    {"const", 5, Linxc_Keyword_const},
+    {"continue", 8, Linxc_Keyword_continue},
+    {"default", 7, Linxc_Keyword_default},
+    {"define", 6, Linxc_Keyword_define},
+    {"delegate", 8, Linxc_Keyword_delegate},
+    {"do", 2, Linxc_Keyword_do},
+    {"double", 6, Linxc_Keyword_double},
+    {"else", 4, Linxc_Keyword_else},
+    {"enum", 4, Linxc_Keyword_enum},
+    {"error", 5, Linxc_Keyword_error},
+    {"extern", 6, Linxc_Keyword_extern},
+    {"false", 5, Linxc_Keyword_false},
+    {"float", 5, Linxc_Keyword_float},
+    {"for", 3, Linxc_Keyword_for},
+    {"goto", 4, Linxc_Keyword_goto},
+    {"i16", 3, Linxc_Keyword_i16},
+    {"i32", 3, Linxc_Keyword_i32},
+    {"i64", 3, Linxc_Keyword_i64},
+    {"i8", 2, Linxc_Keyword_i8},
+    {"if", 2, Linxc_Keyword_if},
+    {"ifdef", 5, Linxc_Keyword_ifdef},
+    {"ifndef", 6, Linxc_Keyword_ifndef},
+    {"imaginary", 9, Linxc_Keyword_imaginary},
+    {"include", 7, Linxc_Keyword_include},
+    {"inline", 6, Linxc_Keyword_inline},
+    {"nameof", 6, Linxc_Keyword_nameof},
+    {"namespace", 9, Linxc_Keyword_namespace},
+    {"noreturn", 8, Linxc_Keyword_noreturn},
+    {"pragma", 6, Linxc_Keyword_pragma},
+    {"register", 8, Linxc_Keyword_register},
+    {"restrict", 8, Linxc_Keyword_restrict},
+    {"return", 6, Linxc_Keyword_return},
+    {"short", 5, Linxc_Keyword_short},
+    {"sizeof", 6, Linxc_Keyword_sizeof},
+    {"static", 6, Linxc_Keyword_static},
+    {"struct", 6, Linxc_Keyword_struct},
+    {"switch", 6, Linxc_Keyword_switch},
+    {"template", 8, Linxc_Keyword_template},
+    {"thread_local", 12, Linxc_Keyword_thread_local},
+    {"trait", 5, Linxc_Keyword_trait},
+    {"true", 4, Linxc_Keyword_true},
+    {"typedef", 7, Linxc_Keyword_typedef},
+    {"typename", 8, Linxc_Keyword_typename},
+    {"typeof", 6, Linxc_Keyword_typeof},
+    {"u16", 3, Linxc_Keyword_u16},
+    {"u32", 3, Linxc_Keyword_u32},
+    {"u64", 3, Linxc_Keyword_u64},
+    {"u8", 2, Linxc_Keyword_u8},
+    {"union", 5, Linxc_Keyword_union},
+    {"void", 4, Linxc_Keyword_void},
+    {"volatile", 8, Linxc_Keyword_volatile},
+    {"while", 5, Linxc_Keyword_while}
+};
+static const usize keywordsCount = sizeof(keywords) / sizeof(LinxcKeyword);
 
-    if (tokenIDPtr != NULL)
+LinxcTokenID LinxcGetKeyword(const char *chars, usize strlen, bool isPreprocessorDirective)
+{
+    usize low = 0;
+    usize high = keywordsCount;
+    while (low < high)
     {
-        LinxcTokenID tokenID = *tokenIDPtr;
-        if (tokenID == Linxc_Keyword_include || tokenID == Linxc_Keyword_define || tokenID == Linxc_Keyword_ifdef || tokenID == Linxc_Keyword_ifndef || tokenID == Linxc_Keyword_error || tokenID == Linxc_Keyword_pragma)
+        usize middle = low + (high - low) / 2;
+        const LinxcKeyword *keyword = &keywords[middle];
+        usize compareLength = keyword->length < strlen ? keyword->length : strlen;
+        i32 comparison = memcmp(keyword->name, chars, compareLength);
+        if (comparison == 0)
+        {
+            //a keyword that is a prefix of chars sorts before it
+            comparison = keyword->length == strlen ? 0 : (keyword->length < strlen ? -1 : 1);
+        }
+
+        if (comparison == 0)
         {
-            if (!isPreprocessorDirective)
+            LinxcTokenID tokenID = keyword->ID;
+            if (tokenID == Linxc_Keyword_include || tokenID == Linxc_Keyword_define || tokenID == Linxc_Keyword_ifdef || tokenID == Linxc_Keyword_ifndef || tokenID == Linxc_Keyword_error || tokenID == Linxc_Keyword_pragma)
             {
-                return Linxc_Invalid;
+                if (!isPreprocessorDirective)
+                {
+                    return Linxc_Invalid;
+                }
             }
+            return tokenID;
+        }
+        else if (comparison < 0)
+        {
+            low = middle + 1;
         }
-        return tokenID;
+        else high = middle;
     }
     return Linxc_Invalid;
 };
\ No newline at end of file
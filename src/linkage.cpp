@@ -0,0 +1,178 @@
+#include <linkage.hpp>
+#include <hashmap.linxc>
+
+/// The file defining each candidate for internal linkage, and the file whose code is currently being walked.
+/// from is NULL while walking code that may end up in another translation unit, such that every reference counts as external.
+struct LinxcLinkageState
+{
+    collections::hashmap<LinxcFunc*, LinxcParsedFile*, collections::PointerKeys> funcOwners;
+    collections::hashmap<LinxcVar*, LinxcParsedFile*, collections::PointerKeys> varOwners;
+    LinxcParsedFile *from;
+};
+
+static void LinxcLinkageUseFunc(LinxcLinkageState *state, LinxcFunc *func)
+{
+    LinxcParsedFile **owner = state->funcOwners.Get(func);
+    if (owner != NULL && *owner != state->from)
+    {
+        func->isFileLocal = false;
+    }
+}
+static void LinxcLinkageUseVar(LinxcLinkageState *state, LinxcVar *var)
+{
+    LinxcParsedFile **owner = state->varOwners.Get(var);
+    if (owner != NULL && *owner != state->from)
+    {
+        var->isFileLocal = false;
+    }
+}
+
+static void LinxcLinkageWalkExpr(LinxcLinkageState *state, LinxcExpression *expr)
+{
+    switch (expr->ID)
+    {
+    case LinxcExpr_Variable:
+        LinxcLinkageUseVar(state, expr->data.variable);
+        break;
+    case LinxcExpr_IncrementVar:
+        LinxcLinkageUseVar(state, expr->data.incrementVariable);
+        break;
+    case LinxcExpr_DecrementVar:
+        LinxcLinkageUseVar(state, expr->data.decrementVariable);
+        break;
+    case LinxcExpr_FunctionRef:
+        LinxcLinkageUseFunc(state, expr->data.functionRef);
+        break;
+    case LinxcExpr_Modified:
+        LinxcLinkageWalkExpr(state, &expr->data.modifiedExpression->expression);
+        break;
+    case LinxcExpr_TypeCast:
+        LinxcLinkageWalkExpr(state, &expr->data.typeCast->expressionToCast);
+        break;
+    case LinxcExpr_Indexer:
+        LinxcLinkageWalkExpr(state, expr->data.indexerCall);
+        break;
+    case LinxcExpr_FuncCall:
+    {
+        LinxcFunctionCall *call = &expr->data.functionCall;
+        LinxcLinkageUseFunc(state, call->func);
+        for (usize i = 0; i < call->inputParams.length; i++)
+        {
+            LinxcLinkageWalkExpr(state, &call->inputParams.data[i]);
+        }
+    }
+    break;
+    case LinxcExpr_OperatorCall:
+        LinxcLinkageWalkExpr(state, &expr->data.operatorCall->leftExpr);
+        LinxcLinkageWalkExpr(state, &expr->data.operatorCall->rightExpr);
+        break;
+    default:
+        break;
+    }
+}
+static void LinxcLinkageWalkBody(LinxcLinkageState *state, collections::vector<LinxcStatement> *body)
+{
+    for (usize i = 0; i < body->count; i++)
+    {
+        LinxcStatement *stmt = body->Get(i);
+        if (stmt->ID == LinxcStmt_Expr)
+        {
+            LinxcLinkageWalkExpr(state, &stmt->data.expression);
+        }
+        else if (stmt->ID == LinxcStmt_Return)
+        {
+            LinxcLinkageWalkExpr(state, &stmt->data.returnStatement);
+        }
+        else if (stmt->ID == LinxcStmt_VarDecl && stmt->data.varDeclaration->defaultValue.present)
+        {
+            LinxcLinkageWalkExpr(state, &stmt->data.varDeclaration->defaultValue.value);
+        }
+    }
+}
+static void LinxcLinkageWalkFunc(LinxcLinkageState *state, LinxcFunc *func, LinxcParsedFile *file)
+{
+    //default arguments are filled in at the call site, which may be in any file
+    state->from = NULL;
+    for (usize i = 0; i < func->arguments.length; i++)
+    {
+        if (func->arguments.data[i].defaultValue.present)
+        {
+            LinxcLinkageWalkExpr(state, &func->arguments.data[i].defaultValue.value);
+        }
+    }
+    //the methods of a template are defined by every specialization, in the source of all of them
+    state->from = func->methodOf != NULL && func->methodOf->isDependent ? NULL : file;
+    LinxcLinkageWalkBody(state, &func->body);
+}
+
+void LinxcInferLinkage(LinxcNamespace *rootNamespace, LinxcParsedFile **files, usize count)
+{
+    LinxcFunc *mainFunc = NULL;
+    LinxcSymbolTable *symbols = &rootNamespace->symbols;
+    for (u32 i = 0; i < symbols->capacity; i++)
+    {
+        if (symbols->slots[i].kind == LinxcSymbol_Func && symbols->slots[i].data.function->name == "Main")
+        {
+            mainFunc = symbols->slots[i].data.function;
+        }
+    }
+
+    LinxcLinkageState state;
+    state.funcOwners = collections::hashmap<LinxcFunc*, LinxcParsedFile*, collections::PointerKeys>(&defaultAllocator);
+    state.varOwners = collections::hashmap<LinxcVar*, LinxcParsedFile*, collections::PointerKeys>(&defaultAllocator);
+    state.from = NULL;
+
+    //start from the optimistic assumption and let the walks below disprove it
+    for (usize i = 0; i < count; i++)
+    {
+        LinxcParsedFile *file = files[i];
+        for (usize j = 0; j < file->definedFuncs.count; j++)
+        {
+            LinxcFunc *func = *file->definedFuncs.Get(j);
+            func->isFileLocal = mainFunc != NULL && func != mainFunc && func->methodOf == NULL && func->templateArgs.length == 0 && !(func->attributes & LinxcAttribute_Keep);
+            if (func->isFileLocal)
+            {
+                state.funcOwners.Add(func, file);
+            }
+        }
+        for (usize j = 0; j < file->definedVars.count; j++)
+        {
+            LinxcVar *var = *file->definedVars.Get(j);
+            var->isFileLocal = mainFunc != NULL && !(var->attributes & LinxcAttribute_Keep);
+            if (var->isFileLocal)
+            {
+                state.varOwners.Add(var, file);
+            }
+        }
+    }
+
+    for (usize i = 0; i < count; i++)
+    {
+        LinxcParsedFile *file = files[i];
+        for (usize j = 0; j < file->definedFuncs.count; j++)
+        {
+            LinxcLinkageWalkFunc(&state, *file->definedFuncs.Get(j), file);
+        }
+        //operator overloads are defined static inline in the header, and global initializers may be part of it too
+        for (usize j = 0; j < file->definedTypes.count; j++)
+        {
+            LinxcType *type = *file->definedTypes.Get(j);
+            for (usize k = 0; k < type->operatorOverloads.entries.count; k++)
+            {
+                LinxcLinkageWalkFunc(&state, &type->operatorOverloads.entries.ptr[k].func->function, NULL);
+            }
+        }
+        state.from = NULL;
+        for (usize j = 0; j < file->definedVars.count; j++)
+        {
+            LinxcVar *var = *file->definedVars.Get(j);
+            if (var->defaultValue.present)
+            {
+                LinxcLinkageWalkExpr(&state, &var->defaultValue.value);
+            }
+        }
+    }
+
+    state.varOwners.deinit();
+    state.funcOwners.deinit();
+}
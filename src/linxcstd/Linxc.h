@@ -9,6 +9,12 @@
 #define impl_trait(name)
 #define IsAttribute
 
+//builtin attributes, understood by Linxcc and expanding to nothing elsewhere
+#define noalias
+#define keep
+#define reorder
+#define soa
+
 typedef signed char i8;
 typedef short i16;
 typedef int i32;
@@ -17,4 +23,8 @@ typedef unsigned char u8;
 typedef unsigned short u16;
 typedef unsigned int u32;
 typedef unsigned long long u64;
-typedef unsigned long long usize;
\ No newline at end of file
+typedef unsigned long long usize;
+
+//the allocator interface of generated code, matching the fields of IAllocator
+def_delegate(LinxcAllocFunc, void *, void *, usize);
+def_delegate(LinxcFreeFunc, void, void *, void *);
\ No newline at end of file
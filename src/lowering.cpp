@@ -0,0 +1,371 @@
+#include <lowering.hpp>
+#include <hashmap.linxc>
+#include <vector.linxc>
+
+/// How an expression is used by whatever contains it.
+enum LinxcLoweringUse
+{
+    LinxcLoweringUse_Read,
+    //assigned to, or has a member assigned to
+    LinxcLoweringUse_Write,
+    //has its address taken, including as the this of a method call
+    LinxcLoweringUse_Address
+};
+
+/// The parameters and local variables of the function being walked, each mapped to whether its address is taken anywhere in its body.
+/// Empty for global initializers.
+struct LinxcLoweringScope
+{
+    collections::hashmap<LinxcVar*, bool, collections::PointerKeys> locals;
+};
+
+static bool LinxcIsAssignment(LinxcTokenID op)
+{
+    switch (op)
+    {
+        case Linxc_Equal:
+        case Linxc_PlusEqual:
+        case Linxc_MinusEqual:
+        case Linxc_AsteriskEqual:
+        case Linxc_SlashEqual:
+        case Linxc_PercentEqual:
+        case Linxc_AmpersandEqual:
+        case Linxc_PipeEqual:
+        case Linxc_CaretEqual:
+        case Linxc_AngleBracketAngleBracketLeftEqual:
+        case Linxc_AngleBracketAngleBracketRightEqual:
+            return true;
+        default:
+            return false;
+    }
+}
+static LinxcExpression *LinxcUnscope(LinxcExpression *expr)
+{
+    while (expr->ID == LinxcExpr_OperatorCall && expr->data.operatorCall->operatorType == Linxc_ColonColon)
+    {
+        expr = &expr->data.operatorCall->rightExpr;
+    }
+    return expr;
+}
+//Returns the type of typeExpr if it is a struct held by value that is larger than threshold, NULL otherwise
+static LinxcType *LinxcLargeStruct(LinxcExpression *typeExpr, usize threshold)
+{
+    option<LinxcTypeReference> typeRef = typeExpr->AsTypeReference();
+    if (!typeRef.present || typeRef.value.pointerCount > 0 || typeRef.value.lastType == NULL)
+    {
+        return NULL;
+    }
+    LinxcType *type = typeRef.value.lastType;
+    if (type->primitiveID != LinxcPrimitive_None || type->isDependent || type->size <= threshold)
+    {
+        return NULL;
+    }
+    return type;
+}
+
+LinxcFunctionCall *LinxcCallReturningThroughPointer(LinxcExpression *expr)
+{
+    expr = LinxcUnscope(expr);
+    if (expr->ID == LinxcExpr_FuncCall && expr->data.functionCall.func->returnsThroughPointer)
+    {
+        return &expr->data.functionCall;
+    }
+    return NULL;
+}
+
+//Disproves lowering every parameter of the function scope is the body of that expr writes or takes the address of,
+//and records every local variable whose address it takes
+static void LinxcLoweringWalkUses(LinxcLoweringScope *scope, LinxcExpression *expr, LinxcLoweringUse use)
+{
+    switch (expr->ID)
+    {
+    case LinxcExpr_Variable:
+    {
+        LinxcVar *var = expr->data.variable;
+        if (use != LinxcLoweringUse_Read)
+        {
+            var->isPassedByPointer = false;
+        }
+        bool *addressed = scope->locals.Get(var);
+        if (addressed != NULL && use == LinxcLoweringUse_Address)
+        {
+            *addressed = true;
+        }
+    }
+    break;
+    case LinxcExpr_Modified:
+    {
+        LinxcModifiedExpression *modified = expr->data.modifiedExpression;
+        LinxcLoweringWalkUses(scope, &modified->expression, modified->modification == Linxc_Ampersand ? LinxcLoweringUse_Address : LinxcLoweringUse_Read);
+    }
+    break;
+    case LinxcExpr_TypeCast:
+        LinxcLoweringWalkUses(scope, &expr->data.typeCast->expressionToCast, LinxcLoweringUse_Read);
+        break;
+    case LinxcExpr_Indexer:
+        LinxcLoweringWalkUses(scope, expr->data.indexerCall, LinxcLoweringUse_Read);
+        break;
+    case LinxcExpr_FuncCall:
+        for (usize i = 0; i < expr->data.functionCall.inputParams.length; i++)
+        {
+            LinxcLoweringWalkUses(scope, &expr->data.functionCall.inputParams.data[i], LinxcLoweringUse_Read);
+        }
+        break;
+    case LinxcExpr_OperatorCall:
+    {
+        LinxcOperator *op = expr->data.operatorCall;
+        if (op->operatorType == Linxc_ColonColon)
+        {
+            LinxcLoweringWalkUses(scope, &op->rightExpr, use);
+        }
+        else if (op->operatorType == Linxc_Period || op->operatorType == Linxc_Arrow)
+        {
+            //a method is passed the address of the object it is called on, while a member is used as the object is.
+            //Either way, the left side of -> is only a pointer being read
+            if (op->operatorType == Linxc_Arrow)
+            {
+                LinxcLoweringWalkUses(scope, &op->leftExpr, LinxcLoweringUse_Read);
+            }
+            else LinxcLoweringWalkUses(scope, &op->leftExpr, op->rightExpr.ID == LinxcExpr_FuncCall ? LinxcLoweringUse_Address : use);
+            if (op->rightExpr.ID == LinxcExpr_FuncCall)
+            {
+                LinxcLoweringWalkUses(scope, &op->rightExpr, LinxcLoweringUse_Read);
+            }
+        }
+        else
+        {
+            LinxcLoweringWalkUses(scope, &op->leftExpr, LinxcIsAssignment(op->operatorType) ? LinxcLoweringUse_Write : LinxcLoweringUse_Read);
+            LinxcLoweringWalkUses(scope, &op->rightExpr, LinxcLoweringUse_Read);
+        }
+    }
+    break;
+    default:
+        break;
+    }
+}
+
+//Disproves lowering for every function expr calls or refers to in a way that does not allow it.
+//allowedCall is the one call within expr that may be to a function returning through a pointer, if any
+static void LinxcLoweringWalkCalls(LinxcLoweringScope *scope, LinxcExpression *expr, LinxcExpression *allowedCall)
+{
+    switch (expr->ID)
+    {
+    case LinxcExpr_FunctionRef:
+    {
+        //whoever calls it through the pointer expects its declared signature
+        LinxcFunc *func = expr->data.functionRef;
+        func->returnsThroughPointer = false;
+        for (usize i = 0; i < func->arguments.length; i++)
+        {
+            func->arguments.data[i].isPassedByPointer = false;
+        }
+    }
+    break;
+    case LinxcExpr_Modified:
+        LinxcLoweringWalkCalls(scope, &expr->data.modifiedExpression->expression, allowedCall);
+        break;
+    case LinxcExpr_TypeCast:
+        LinxcLoweringWalkCalls(scope, &expr->data.typeCast->expressionToCast, allowedCall);
+        break;
+    case LinxcExpr_Indexer:
+        LinxcLoweringWalkCalls(scope, expr->data.indexerCall, allowedCall);
+        break;
+    case LinxcExpr_FuncCall:
+    {
+        LinxcFunctionCall *call = &expr->data.functionCall;
+        if (expr != allowedCall)
+        {
+            call->func->returnsThroughPointer = false;
+        }
+        for (usize i = 0; i < call->inputParams.length; i++)
+        {
+            LinxcExpression *input = &call->inputParams.data[i];
+            if (i < call->func->arguments.length && call->func->arguments.data[i].isPassedByPointer)
+            {
+                LinxcExpression *argument = LinxcUnscope(input);
+                bool *addressed = argument->ID == LinxcExpr_Variable ? scope->locals.Get(argument->data.variable) : NULL;
+                if (addressed == NULL || *addressed)
+                {
+                    call->func->arguments.data[i].isPassedByPointer = false;
+                }
+            }
+            LinxcLoweringWalkCalls(scope, input, allowedCall);
+        }
+    }
+    break;
+    case LinxcExpr_OperatorCall:
+        LinxcLoweringWalkCalls(scope, &expr->data.operatorCall->leftExpr, allowedCall);
+        LinxcLoweringWalkCalls(scope, &expr->data.operatorCall->rightExpr, allowedCall);
+        break;
+    default:
+        break;
+    }
+}
+
+static void LinxcLoweringWalkFunc(LinxcFunc *func)
+{
+    LinxcLoweringScope scope;
+    scope.locals = collections::hashmap<LinxcVar*, bool, collections::PointerKeys>(&defaultAllocator);
+    for (usize i = 0; i < func->arguments.length; i++)
+    {
+        scope.locals.Add(&func->arguments.data[i], false);
+    }
+    for (usize i = 0; i < func->body.count; i++)
+    {
+        LinxcStatement *stmt = func->body.Get(i);
+        if (stmt->ID == LinxcStmt_VarDecl)
+        {
+            scope.locals.Add(stmt->data.varDeclaration, false);
+        }
+    }
+
+    //every address taken has to be known before any call can be judged
+    for (usize i = 0; i < func->body.count; i++)
+    {
+        LinxcStatement *stmt = func->body.Get(i);
+        if (stmt->ID == LinxcStmt_Expr)
+        {
+            LinxcLoweringWalkUses(&scope, &stmt->data.expression, LinxcLoweringUse_Read);
+        }
+        else if (stmt->ID == LinxcStmt_Return)
+        {
+            LinxcLoweringWalkUses(&scope, &stmt->data.returnStatement, LinxcLoweringUse_Read);
+        }
+        else if (stmt->ID == LinxcStmt_VarDecl && stmt->data.varDeclaration->defaultValue.present)
+        {
+            LinxcLoweringWalkUses(&scope, &stmt->data.varDeclaration->defaultValue.value, LinxcLoweringUse_Read);
+        }
+    }
+    for (usize i = 0; i < func->body.count; i++)
+    {
+        LinxcStatement *stmt = func->body.Get(i);
+        if (stmt->ID == LinxcStmt_Expr)
+        {
+            //a call discarding its result, or assigning it to something
+            LinxcExpression *expr = &stmt->data.expression;
+            LinxcExpression *allowedCall = LinxcUnscope(expr);
+            if (expr->ID == LinxcExpr_OperatorCall && expr->data.operatorCall->operatorType == Linxc_Equal)
+            {
+                allowedCall = LinxcUnscope(&expr->data.operatorCall->rightExpr);
+            }
+            LinxcLoweringWalkCalls(&scope, expr, allowedCall);
+        }
+        else if (stmt->ID == LinxcStmt_Return)
+        {
+            LinxcLoweringWalkCalls(&scope, &stmt->data.returnStatement, LinxcUnscope(&stmt->data.returnStatement));
+        }
+        else if (stmt->ID == LinxcStmt_VarDecl && stmt->data.varDeclaration->defaultValue.present)
+        {
+            //a const variable can only be initialized, not written to afterwards
+            LinxcVar *var = stmt->data.varDeclaration;
+            LinxcLoweringWalkCalls(&scope, &var->defaultValue.value, var->isConst ? NULL : LinxcUnscope(&var->defaultValue.value));
+        }
+    }
+
+    scope.locals.deinit();
+}
+
+/// Every function body and global initializer that may call a function, along with the candidates for lowering.
+struct LinxcLoweringDecls
+{
+    collections::vector<LinxcFunc*> funcs;
+    collections::vector<LinxcVar*> globals;
+    LinxcFunc *mainFunc;
+    usize threshold;
+};
+//Starts from the optimistic assumption for func, which the walks disprove
+static void LinxcLoweringCollectFunc(LinxcLoweringDecls *decls, LinxcFunc *func)
+{
+    //only file-local functions, whose signatures no other translation unit or library user sees
+    bool isCandidate = func->isFileLocal && decls->mainFunc != NULL && func != decls->mainFunc && func->methodOf == NULL && func->templateArgs.length == 0 && !(func->attributes & LinxcAttribute_Keep);
+    func->returnsThroughPointer = isCandidate && LinxcLargeStruct(&func->returnType, decls->threshold) != NULL;
+    for (usize i = 0; i < func->arguments.length; i++)
+    {
+        LinxcVar *arg = &func->arguments.data[i];
+        arg->isPassedByPointer = isCandidate && !arg->defaultValue.present && LinxcLargeStruct(&arg->type, decls->threshold) != NULL;
+    }
+    decls->funcs.Add(func);
+}
+static void LinxcLoweringCollectType(LinxcLoweringDecls *decls, LinxcType *type)
+{
+    //templates are never transpiled, only their specializations, whose bodies are copies of theirs
+    if (type->isDependent)
+    {
+        return;
+    }
+    for (usize i = 0; i < type->functions.count; i++)
+    {
+        LinxcLoweringCollectFunc(decls, type->functions.Get(i));
+    }
+    for (usize i = 0; i < type->operatorOverloads.entries.count; i++)
+    {
+        LinxcLoweringCollectFunc(decls, &type->operatorOverloads.entries.ptr[i].func->function);
+    }
+    for (usize i = 0; i < type->subTypes.count; i++)
+    {
+        LinxcLoweringCollectType(decls, type->subTypes.Get(i));
+    }
+}
+static void LinxcLoweringCollect(LinxcLoweringDecls *decls, LinxcNamespace *nameSpace)
+{
+    LinxcSymbolTable *symbols = &nameSpace->symbols;
+    for (u32 i = 0; i < symbols->capacity; i++)
+    {
+        LinxcSymbol *symbol = &symbols->slots[i];
+        switch (symbol->kind)
+        {
+        case LinxcSymbol_Func:
+            LinxcLoweringCollectFunc(decls, symbol->data.function);
+            break;
+        case LinxcSymbol_Var:
+            decls->globals.Add(symbol->data.variable);
+            break;
+        case LinxcSymbol_Type:
+            LinxcLoweringCollectType(decls, symbol->data.type);
+            break;
+        case LinxcSymbol_Namespace:
+            LinxcLoweringCollect(decls, symbol->data.namespaceRef);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+void LinxcLowerLargeStructs(LinxcNamespace *rootNamespace, usize threshold)
+{
+    LinxcLoweringDecls decls;
+    decls.funcs = collections::vector<LinxcFunc*>(&defaultAllocator);
+    decls.globals = collections::vector<LinxcVar*>(&defaultAllocator);
+    decls.mainFunc = NULL;
+    decls.threshold = threshold;
+
+    LinxcSymbolTable *symbols = &rootNamespace->symbols;
+    for (u32 i = 0; i < symbols->capacity; i++)
+    {
+        if (symbols->slots[i].kind == LinxcSymbol_Func && symbols->slots[i].data.function->name == "Main")
+        {
+            decls.mainFunc = symbols->slots[i].data.function;
+        }
+    }
+    LinxcLoweringCollect(&decls, rootNamespace);
+
+    for (usize i = 0; i < decls.funcs.count; i++)
+    {
+        LinxcLoweringWalkFunc(decls.funcs.ptr[i]);
+    }
+    //global initializers have no locals to point to, nor a statement to hold a call of their own
+    LinxcLoweringScope scope;
+    scope.locals = collections::hashmap<LinxcVar*, bool, collections::PointerKeys>(&defaultAllocator);
+    for (usize i = 0; i < decls.globals.count; i++)
+    {
+        if (decls.globals.ptr[i]->defaultValue.present)
+        {
+            LinxcLoweringWalkCalls(&scope, &decls.globals.ptr[i]->defaultValue.value, NULL);
+        }
+    }
+
+    scope.locals.deinit();
+    decls.globals.deinit();
+    decls.funcs.deinit();
+}
@@ -1,7 +1,17 @@
 ﻿#include <parser.hpp>
+#include <builtins.hpp>
 #include <stdio.h>
 #include <path.hpp>
 #include <ArenaAllocator.hpp>
+#include <threads.hpp>
+#include <alias.hpp>
+#include <fold.hpp>
+#include <linkage.hpp>
+#include <lowering.hpp>
+
+/// The number of function definitions transpiled by a single job. Small enough to balance uneven files across threads,
+/// large enough that a job's writer amortizes its allocation.
+#define LINXC_TRANSPILE_FUNCS_PER_JOB 32
 
 LinxcParserState::LinxcParserState(LinxcParser *myParser, LinxcParsedFile *currentFile, LinxcTokenizer *myTokenizer, LinxcEndOn endsOn, bool isTopLevel, bool isParsingLinxci)
 {
@@ -13,205 +23,34 @@ LinxcParserState::LinxcParserState(LinxcParser *myParser, LinxcParsedFile *curre
     this->currentNamespace = &myParser->globalNamespace;
     this->currentFunction = NULL;
     this->parentType = NULL;
-    this->varsInScope = collections::hashmap<string, LinxcVar *>(&defaultAllocator, &stringHash, &stringEql);
+    this->varsInScope = collections::hashmap<string, LinxcVar *, StringKeys>(&defaultAllocator);
     this->parsingLinxci = isParsingLinxci;
+    this->pendingTemplateCloses = 0;
 }
 LinxcParser::LinxcParser(IAllocator *allocator)
 {
     this->allocator = allocator;
     this->globalNamespace = LinxcNamespace(allocator, string());
+    this->typeTable = LinxcTypeTable(allocator);
+    this->operatorIndex = LinxcOperatorIndex();
     this->thisKeyword = string(allocator, "this");
-
-    const i32 numIntegerTypes = 8;
-    const i32 numNumericTypes = 10;// 11; TODO: Deal with char, probably will remove it
-    const i32 numPrimitiveTypes = 13;
-
-    //every numeric type can be explicitly compared to every other numeric type
-    const char *primitiveTypes[numPrimitiveTypes] = {"u8", "u16", "u32", "u64", "i8", "i16", "i32", "i64", "float", "double", "char", "void", "bool" };
-    string nameStrings[numPrimitiveTypes];
-    LinxcType* primitiveTypePtrs[numPrimitiveTypes];
-    for (i32 i = 0; i < numPrimitiveTypes; i++)
-    {
-        nameStrings[i] = string(allocator, primitiveTypes[i]);
-        this->globalNamespace.types.Add(nameStrings[i], LinxcType(allocator, nameStrings[i], &this->globalNamespace, NULL));
-        primitiveTypePtrs[i] = this->globalNamespace.types.Get(nameStrings[i]);
-        if (i == 0)
-        {
-            typeofU8 = primitiveTypePtrs[i];
-        }
-    }
-
-    //all types support ==, !=
-    //all numeric types support +, -, /, *
-    //integer types support <<, >>, |, ^, &
-    //bools support &&, ||, !
-
-    //using == or != on any type MUST convert it into a bool
-    //+, -, /, * MUST return either original type or operatesWith type
-    //<<, >>, |, ^, & MUST return original type
-
-    //all implicit casts may be used explicitly
-    //an explicit cast may not be used implicitly
-
-    //all integer types cast to all other integer types
-    for (i32 i = 0; i < numIntegerTypes; i++)
-    {
-        for (i32 j = 0; j < numIntegerTypes; j++)
-        {
-            if (i != j)
-            {
-                //if casting up and is same sign, implicit
-                //else, explicit
-                bool sameSign = (i < 4 && j < 4) || (i >= 4 && j >= 4);
-                bool implicit = sameSign && j > i;
-
-                LinxcOperatorFunc defaultCast = NewDefaultCast(primitiveTypePtrs, i, j, implicit);
-                primitiveTypePtrs[i]->operatorOverloads.Add(defaultCast.operatorOverride, defaultCast);
-            }
-        }
-        //integers cast to float and double implicitly
-        LinxcOperatorFunc toFloat = NewDefaultCast(primitiveTypePtrs, i, numIntegerTypes, true);
-        primitiveTypePtrs[i]->operatorOverloads.Add(toFloat.operatorOverride, toFloat);
-
-        LinxcOperatorFunc toDouble = NewDefaultCast(primitiveTypePtrs, i, numIntegerTypes + 1, true);
-        primitiveTypePtrs[i]->operatorOverloads.Add(toDouble.operatorOverride, toDouble);
-    }
-    //float and double cast explicitly to all integer types and each other
-    for (i32 i = numIntegerTypes; i < numIntegerTypes + 2; i++)
-    {
-        for (i32 j = 0; j < numIntegerTypes + 2; j++)
-        {
-            if (i != j)
-            {
-                LinxcOperatorFunc defaultCast = NewDefaultCast(primitiveTypePtrs, i, j, false);
-                primitiveTypePtrs[i]->operatorOverloads.Add(defaultCast.operatorOverride, defaultCast);
-            }
-        }
-    }
-    //all numeric types can be +, -, /, *, ==, != with each other
-    //TODO: Settle the bitshift and bitwise comparison operators
-    //because typeA + typeB = typeB + typeA, we should avoid adding the duplicates
-    for (i32 i = 0; i < numNumericTypes; i++)
-    {
-        LinxcOperatorFunc operatorSet = NewDefaultOperator(primitiveTypePtrs, i, i, Linxc_Equal);
-        primitiveTypePtrs[i]->operatorOverloads.Add(operatorSet.operatorOverride, operatorSet);
-
-        for (i32 j = 0; j < numNumericTypes; j++)
-        {
-            LinxcOperatorImpl opposite;
-            opposite.implicit = false;
-            opposite.ID = LinxcOverloadIs_Operator;
-            opposite.op = Linxc_Plus;
-            opposite.myType = LinxcTypeReference(primitiveTypePtrs[j]);
-            opposite.otherType = LinxcTypeReference(primitiveTypePtrs[i]);
-
-            if (!primitiveTypePtrs[j]->operatorOverloads.Contains(opposite))
-            {
-                LinxcOperatorFunc operatorAdd = NewDefaultOperator(primitiveTypePtrs, i, j, Linxc_Plus);
-                primitiveTypePtrs[i]->operatorOverloads.Add(operatorAdd.operatorOverride, operatorAdd);
-
-                LinxcOperatorFunc operatorSubtract = NewDefaultOperator(primitiveTypePtrs, i, j, Linxc_Minus);
-                primitiveTypePtrs[i]->operatorOverloads.Add(operatorSubtract.operatorOverride, operatorSubtract);
-
-                LinxcOperatorFunc operatorMult = NewDefaultOperator(primitiveTypePtrs, i, j, Linxc_Asterisk);
-                primitiveTypePtrs[i]->operatorOverloads.Add(operatorMult.operatorOverride, operatorMult);
-
-                LinxcOperatorFunc operatorDiv = NewDefaultOperator(primitiveTypePtrs, i, j, Linxc_Slash);
-                primitiveTypePtrs[i]->operatorOverloads.Add(operatorDiv.operatorOverride, operatorDiv);
-            
-                LinxcOperatorFunc operatorEquals = NewDefaultOperator(primitiveTypePtrs, i, j, Linxc_EqualEqual);
-                primitiveTypePtrs[i]->operatorOverloads.Add(operatorEquals.operatorOverride, operatorEquals);
-
-                LinxcOperatorFunc operatorNotEquals = NewDefaultOperator(primitiveTypePtrs, i, j, Linxc_BangEqual);
-                primitiveTypePtrs[i]->operatorOverloads.Add(operatorNotEquals.operatorOverride, operatorNotEquals);
-            }
-        }
-    }
-    //bools can be ==, !=, &&, ||
-    {
-        LinxcOperatorFunc boolEquals = NewDefaultOperator(primitiveTypePtrs, 12, 12, Linxc_EqualEqual);
-        LinxcOperatorFunc boolNotEquals = NewDefaultOperator(primitiveTypePtrs, 12, 12, Linxc_BangEqual);
-        LinxcOperatorFunc boolAnd = NewDefaultOperator(primitiveTypePtrs, 12, 12, Linxc_AmpersandAmpersand);
-        LinxcOperatorFunc boolOr = NewDefaultOperator(primitiveTypePtrs, 12, 12, Linxc_PipePipe);
-
-        primitiveTypePtrs[12]->operatorOverloads.Add(boolEquals.operatorOverride, boolEquals);
-        primitiveTypePtrs[12]->operatorOverloads.Add(boolNotEquals.operatorOverride, boolNotEquals);
-        primitiveTypePtrs[12]->operatorOverloads.Add(boolAnd.operatorOverride, boolAnd);
-        primitiveTypePtrs[12]->operatorOverloads.Add(boolOr.operatorOverride, boolOr);
-    }
-
-    this->parsedFiles = collections::hashmap<string, LinxcParsedFile>(allocator, &stringHash, &stringEql);
-    this->parsingFiles = collections::hashset<string>(allocator, &stringHash, &stringEql);
+    this->transpileThreads = 0;
+    this->preparedForTranspile = false;
+    this->eliminateUnreachable = false;
+    this->eliminated = LinxcEliminationReport(allocator);
+    this->layoutTarget = LinxcHostLayoutTarget();
+    this->reportLayouts = false;
+    this->layoutReport = LinxcWriter(allocator);
+    this->largeStructThreshold = 64;
+    this->templateInstances = LinxcTemplateInstances(allocator);
+
+    //the primitive types and their operators are static builtins, see builtins.hpp
+    this->typeofU8 = LinxcGetPrimitiveType(LinxcPrimitive_u8);
+
+    this->parsedFiles = collections::hashmap<string, LinxcParsedFile, StringKeys>(allocator);
+    this->parsingFiles = collections::hashset<string, StringKeys>(allocator);
     this->includedFiles = collections::vector<string>(allocator);
     this->includeDirectories = collections::vector<string>(allocator);
-    this->nameToToken = collections::hashmap<string, LinxcTokenID>(allocator, &stringHash, &stringEql);
-
-    nameToToken.Add(string(nameToToken.allocator, "include"), Linxc_Keyword_include);
-    nameToToken.Add(string(nameToToken.allocator, "alignas"), Linxc_Keyword_alignas);
-    nameToToken.Add(string(nameToToken.allocator, "alignof"), Linxc_Keyword_alignof);
-    nameToToken.Add(string(nameToToken.allocator, "atomic"), Linxc_Keyword_atomic);
-    nameToToken.Add(string(nameToToken.allocator, "auto"), Linxc_Keyword_auto);
-    nameToToken.Add(string(nameToToken.allocator, "bool"), Linxc_Keyword_bool);
-    nameToToken.Add(string(nameToToken.allocator, "break"), Linxc_Keyword_break);
-    nameToToken.Add(string(nameToToken.allocator, "case"), Linxc_Keyword_case);
-    nameToToken.Add(string(nameToToken.allocator, "char"), Linxc_Keyword_char);
-    nameToToken.Add(string(nameToToken.allocator, "complex"), Linxc_Keyword_complex);
-    nameToToken.Add(string(nameToToken.allocator, "const"), Linxc_Keyword_const);
-    nameToToken.Add(string(nameToToken.allocator, "continue"), Linxc_Keyword_continue);
-    nameToToken.Add(string(nameToToken.allocator, "default"), Linxc_Keyword_default);
-    nameToToken.Add(string(nameToToken.allocator, "define"), Linxc_Keyword_define);
-    nameToToken.Add(string(nameToToken.allocator, "delegate"), Linxc_Keyword_delegate);
-    nameToToken.Add(string(nameToToken.allocator, "do"), Linxc_Keyword_do);
-    nameToToken.Add(string(nameToToken.allocator, "double"), Linxc_Keyword_double);
-    nameToToken.Add(string(nameToToken.allocator, "else"), Linxc_Keyword_else);
-    nameToToken.Add(string(nameToToken.allocator, "enum"), Linxc_Keyword_enum);
-    nameToToken.Add(string(nameToToken.allocator, "error"), Linxc_Keyword_error);
-    nameToToken.Add(string(nameToToken.allocator, "extern"), Linxc_Keyword_extern);
-    nameToToken.Add(string(nameToToken.allocator, "false"), Linxc_Keyword_false);
-    nameToToken.Add(string(nameToToken.allocator, "float"), Linxc_Keyword_float);
-    nameToToken.Add(string(nameToToken.allocator, "for"), Linxc_Keyword_for);
-    nameToToken.Add(string(nameToToken.allocator, "goto"), Linxc_Keyword_goto);
-    nameToToken.Add(string(nameToToken.allocator, "i16"), Linxc_Keyword_i16);
-    nameToToken.Add(string(nameToToken.allocator, "i32"), Linxc_Keyword_i32);
-    nameToToken.Add(string(nameToToken.allocator, "i64"), Linxc_Keyword_i64);
-    nameToToken.Add(string(nameToToken.allocator, "i8"), Linxc_Keyword_i8);
-    nameToToken.Add(string(nameToToken.allocator, "if"), Linxc_Keyword_if);
-    nameToToken.Add(string(nameToToken.allocator, "ifdef"), Linxc_Keyword_ifdef);
-    nameToToken.Add(string(nameToToken.allocator, "ifndef"), Linxc_Keyword_ifndef);
-    nameToToken.Add(string(nameToToken.allocator, "imaginary"), Linxc_Keyword_imaginary);
-    nameToToken.Add(string(nameToToken.allocator, "include"), Linxc_Keyword_include);
-    nameToToken.Add(string(nameToToken.allocator, "inline"), Linxc_Keyword_inline);
-    //nameToToken.Add(string(nameToToken.allocator, "int"), Linxc_Keyword_int);
-    //nameToToken.Add(string(nameToToken.allocator, "long"), Linxc_Keyword_long);
-    nameToToken.Add(string(nameToToken.allocator, "nameof"), Linxc_Keyword_nameof);
-    nameToToken.Add(string(nameToToken.allocator, "namespace"), Linxc_Keyword_namespace);
-    nameToToken.Add(string(nameToToken.allocator, "noreturn"), Linxc_Keyword_noreturn);
-    nameToToken.Add(string(nameToToken.allocator, "pragma"), Linxc_Keyword_pragma);
-    nameToToken.Add(string(nameToToken.allocator, "register"), Linxc_Keyword_register);
-    nameToToken.Add(string(nameToToken.allocator, "restrict"), Linxc_Keyword_restrict);
-    nameToToken.Add(string(nameToToken.allocator, "return"), Linxc_Keyword_return);
-    nameToToken.Add(string(nameToToken.allocator, "short"), Linxc_Keyword_short);
-    //nameToToken.Add(string(nameToToken.allocator, "signed"), Linxc_Keyword_signed);
-    nameToToken.Add(string(nameToToken.allocator, "sizeof"), Linxc_Keyword_sizeof);
-    nameToToken.Add(string(nameToToken.allocator, "static"), Linxc_Keyword_static);
-    nameToToken.Add(string(nameToToken.allocator, "struct"), Linxc_Keyword_struct);
-    nameToToken.Add(string(nameToToken.allocator, "switch"), Linxc_Keyword_switch);
-    nameToToken.Add(string(nameToToken.allocator, "template"), Linxc_Keyword_template);
-    nameToToken.Add(string(nameToToken.allocator, "thread_local"), Linxc_Keyword_thread_local);
-    nameToToken.Add(string(nameToToken.allocator, "trait"), Linxc_Keyword_trait);
-    nameToToken.Add(string(nameToToken.allocator, "true"), Linxc_Keyword_true);
-    nameToToken.Add(string(nameToToken.allocator, "typedef"), Linxc_Keyword_typedef);
-    nameToToken.Add(string(nameToToken.allocator, "typename"), Linxc_Keyword_typename);
-    nameToToken.Add(string(nameToToken.allocator, "typeof"), Linxc_Keyword_typeof);
-    nameToToken.Add(string(nameToToken.allocator, "u16"), Linxc_Keyword_u16);
-    nameToToken.Add(string(nameToToken.allocator, "u32"), Linxc_Keyword_u32);
-    nameToToken.Add(string(nameToToken.allocator, "u64"), Linxc_Keyword_u64);
-    nameToToken.Add(string(nameToToken.allocator, "u8"), Linxc_Keyword_u8);
-    nameToToken.Add(string(nameToToken.allocator, "union"), Linxc_Keyword_union);
-    nameToToken.Add(string(nameToToken.allocator, "void"), Linxc_Keyword_void);
-    nameToToken.Add(string(nameToToken.allocator, "volatile"), Linxc_Keyword_volatile);
-    nameToToken.Add(string(nameToToken.allocator, "while"), Linxc_Keyword_while);
-    nameToToken.Add(string(nameToToken.allocator, "attribute"), Linxc_keyword_attribute);
 }
 void LinxcParserState::deinit()
 {
@@ -230,6 +69,10 @@ void LinxcParser::deinit()
         this->includeDirectories.Get(i)->deinit();
     }
     this->includeDirectories.deinit();
+    this->eliminated.deinit();
+    this->layoutReport.deinit();
+    this->operatorIndex.deinit();
+    this->templateInstances.deinit();
 
     //TODO: deinit parsedFiles, parsingFiles
 }
@@ -260,8 +103,9 @@ LinxcParsedFile *LinxcParser::ParseFile(string fileFullPath, string includeName,
 
     LinxcParsedFile file = LinxcParsedFile(this->allocator, fileFullPath, includeName);
     this->parsingFiles.Add(includeName);
+    this->preparedForTranspile = false;
 
-    LinxcTokenizer tokenizer = LinxcTokenizer(fileContents.buffer, fileContents.length, &this->nameToToken);
+    LinxcTokenizer tokenizer = LinxcTokenizer(fileContents.buffer, fileContents.length);
     
     if (this->TokenizeFile(&tokenizer, allocator, &file))
     {
@@ -295,124 +139,9 @@ string LinxcParser::FullPathFromIncludeName(string includeName)
     }
     return string();
 }
-LinxcOperatorFunc LinxcParser::NewDefaultCast(LinxcType** primitiveTypePtrs, i32 myTypeIndex, i32 otherTypeIndex, bool isImplicit)
-{
-    LinxcType* myType = primitiveTypePtrs[myTypeIndex];
-    LinxcType* toType = primitiveTypePtrs[otherTypeIndex];
-    //i32 toTypeIndex = GetOperationResult((LinxcTokenID)(myTypeIndex + Linxc_Keyword_u8), (LinxcTokenID)(otherTypeIndex + Linxc_Keyword_u8)) - Linxc_Keyword_u8;
-    //LinxcTypeReference toType = LinxcTypeReference(primitiveTypePtrs[toTypeIndex]);
-
-    LinxcOperatorImpl cast;
-    cast.implicit = isImplicit;
-    cast.ID = LinxcOverloadIs_Cast;
-    cast.otherType = toType;
-    cast.op = Linxc_Invalid;
-    cast.myType = LinxcTypeReference(myType);
-
-    LinxcExpression returnType;
-    returnType.resolvesTo.lastType = NULL;
-    returnType.data.typeRef = toType;
-    returnType.ID = LinxcExpr_TypeRef; //what we're casting into
-    LinxcFunc castFunc = LinxcFunc(string(), returnType); //these functions don't need names
-    
-    //cast functions don't have arguments, eg: (float)integer has no argument
-    castFunc.arguments = collections::Array<LinxcVar>();
-
-    LinxcOperatorFunc result;
-    result.operatorOverride = cast;
-    result.function = castFunc;
-
-    return result;
-}
-LinxcOperatorFunc LinxcParser::NewDefaultOperator(LinxcType** primitiveTypePtrs, i32 myTypeIndex, i32 otherTypeIndex, LinxcTokenID op)
-{
-    //unsigned comes before signed in the enum
-    LinxcType* myType = primitiveTypePtrs[myTypeIndex];
-    LinxcType* otherType = primitiveTypePtrs[otherTypeIndex];
-    i32 returnTypeIndex = 0;
-    
-    if (op == Linxc_EqualEqual || op == Linxc_BangEqual)
-    {
-        returnTypeIndex = 12; //== and != MUST result in bool
-    }
-    else
-    {
-        if (myTypeIndex < 8 && otherTypeIndex < 8)
-        {
-            bool IAmSigned = myTypeIndex >= 4;
-            bool otherIsSigned = otherTypeIndex >= 4;
-            bool sameSign = IAmSigned == otherIsSigned;//(myTypeIndex < 4 && otherTypeIndex < 4) || (myTypeIndex >= 4 && otherTypeIndex >= 4);
-
-            if (sameSign)
-            {
-                returnTypeIndex = otherTypeIndex > myTypeIndex ? otherTypeIndex : myTypeIndex;
-            }
-            else
-            {
-                //when signed op unsigned, convert signed to unsigned
-                if (IAmSigned && !otherIsSigned)
-                {
-                    i32 meUnsignedIndex = myTypeIndex - 4;
-                    returnTypeIndex = otherTypeIndex > meUnsignedIndex ? otherTypeIndex : meUnsignedIndex;
-                }
-                else// if (!IAmSigned && otherIsSigned)
-                {
-                    i32 otherUnsignedIndex = otherTypeIndex - 4;
-                    returnTypeIndex = otherUnsignedIndex > myTypeIndex ? otherUnsignedIndex : myTypeIndex;
-                }
-            }
-        }
-        else
-        {
-            //float * double = double
-            if (myTypeIndex == otherTypeIndex)
-            {
-                returnTypeIndex = myTypeIndex;
-            }
-            else
-            {
-                returnTypeIndex = otherTypeIndex > myTypeIndex ? otherTypeIndex : myTypeIndex;
-            }
-        }
-    }
-    
-    LinxcType* returnType = primitiveTypePtrs[returnTypeIndex];
-    LinxcOperatorImpl operation;
-    operation.myType = LinxcTypeReference(myType);
-    operation.otherType = LinxcTypeReference(otherType);
-    operation.op = op;
-    operation.ID = LinxcOverloadIs_Operator;
-    operation.implicit = false; //doesn't matter, just make sure we reset it
-    
-    LinxcExpression returnTypeExpr;
-    returnTypeExpr.resolvesTo.lastType = NULL;
-    returnTypeExpr.data.typeRef = returnType;
-    returnTypeExpr.ID = LinxcExpr_TypeRef; //what we're returning after the operation
-
-    LinxcFunc opFunc = LinxcFunc(string(), returnTypeExpr); //these functions don't need names
-    
-    //our sole argument is the other type. EG: intVar + floatVar = intVar.Add(floatVar)
-    LinxcVar* inputArg = (LinxcVar*)this->allocator->Allocate(sizeof(LinxcVar));
-    inputArg->type.ID = LinxcExpr_TypeRef;
-    inputArg->type.data.typeRef = LinxcTypeReference(otherType);
-    inputArg->type.resolvesTo.lastType = NULL;
-    inputArg->name = string(this->allocator, "other");
-    opFunc.arguments = collections::Array<LinxcVar>(this->allocator, inputArg, 1);
-
-    LinxcOperatorFunc result;
-    result.operatorOverride = operation;
-    result.function = opFunc;
-
-    //string debug = result.ToString(&defaultAllocator);
-    //printf("%s\n", debug.buffer);
-    //debug.deinit();
-
-    return result;
-}
-
 bool LinxcParser::TokenizeFile(LinxcTokenizer* tokenizer, IAllocator* allocator, LinxcParsedFile* parsingFile)
 {
-    collections::hashmap<string, LinxcMacro*> identifierToMacro = collections::hashmap<string, LinxcMacro*>(&defaultAllocator, &stringHash, &stringEql);
+    collections::hashmap<string, LinxcMacro*, StringKeys> identifierToMacro = collections::hashmap<string, LinxcMacro*, StringKeys>(&defaultAllocator);
     tokenizer->tokenStream = collections::vector<LinxcToken>(allocator);
     bool nextMacroIsAttribute = false;
     while (true)
@@ -601,7 +330,7 @@ bool LinxcParser::TokenizeFile(LinxcTokenizer* tokenizer, IAllocator* allocator,
                             ArenaAllocator arena = ArenaAllocator(&defaultAllocator);
                             
                             collections::vector<LinxcToken> tokensInArg = collections::vector<LinxcToken>(&arena.asAllocator);
-                            collections::hashmap<string, collections::Array<LinxcToken>> argsInMacro = collections::hashmap<string, collections::Array<LinxcToken>>(&arena.asAllocator, &stringHash, &stringEql);
+                            collections::hashmap<string, collections::Array<LinxcToken>, StringKeys> argsInMacro = collections::hashmap<string, collections::Array<LinxcToken>, StringKeys>(&arena.asAllocator);
 
                             while (next.ID != Linxc_RParen)
                             {
@@ -910,7 +639,9 @@ option<LinxcExpression> LinxcParser::ParseExpressionPrimary(LinxcParserState *st
                         finalResult.ID = LinxcExpr_FuncCall;
                         finalResult.data.functionCall.func = result.value.data.functionRef;
                         finalResult.data.functionCall.inputParams = inputArgs.ToOwnedArrayWith(this->allocator);
-                        finalResult.data.functionCall.templateSpecializations = collections::Array<LinxcTypeReference>(); //todo
+                        //methods of a specialization are called through the arguments it was specialized with
+                        LinxcType *calledOn = result.value.data.functionRef->methodOf;
+                        finalResult.data.functionCall.templateSpecializations = calledOn != NULL && calledOn->templateOf != NULL ? calledOn->instanceArgs : collections::Array<LinxcTypeReference>();
                         finalResult.resolvesTo = result.value.data.functionRef->returnType.AsTypeReference().value;
 
                         return option<LinxcExpression>(finalResult);
@@ -924,6 +655,104 @@ option<LinxcExpression> LinxcParser::ParseExpressionPrimary(LinxcParserState *st
                 return result;
             }
             break;
+        case Linxc_Keyword_sizeof:
+        case Linxc_Keyword_nameof:
+        case Linxc_Keyword_typeof:
+            {
+                if (state->tokenizer->NextUntilValid().ID != Linxc_LParen)
+                {
+                    ERR_MSG msg = ERR_MSG(this->allocator, "Expected ( after ");
+                    msg.Append(LinxcTokenIDToString(token.ID));
+                    state->parsingFile->errors.Add(msg);
+                    return option<LinxcExpression>();
+                }
+                option<LinxcExpression> primaryOpt = this->ParseExpressionPrimary(state);
+                if (!primaryOpt.present)
+                {
+                    return option<LinxcExpression>();
+                }
+                LinxcExpression operand = this->ParseExpression(state, primaryOpt.value, -1);
+                if (state->tokenizer->PeekNextUntilValid().ID == Linxc_RParen)
+                {
+                    state->tokenizer->NextUntilValid();
+                }
+                else
+                {
+                    state->parsingFile->errors.Add(ERR_MSG(this->allocator, "Expected )"));
+                    return option<LinxcExpression>();
+                }
+
+                LinxcExpression result;
+                if (token.ID == Linxc_Keyword_nameof)
+                {
+                    //resolved to a string literal straight away, as the name is all we need
+                    LinxcExpression *named = &operand;
+                    while (named->ID == LinxcExpr_OperatorCall && (named->data.operatorCall->operatorType == Linxc_ColonColon || named->data.operatorCall->operatorType == Linxc_Period || named->data.operatorCall->operatorType == Linxc_Arrow))
+                    {
+                        named = &named->data.operatorCall->rightExpr;
+                    }
+                    string *name = NULL;
+                    switch (named->ID)
+                    {
+                    case LinxcExpr_Variable:
+                        name = &named->data.variable->name;
+                        break;
+                    case LinxcExpr_FunctionRef:
+                        name = &named->data.functionRef->name;
+                        break;
+                    case LinxcExpr_TypeRef:
+                        name = &named->data.typeRef.lastType->name;
+                        break;
+                    case LinxcExpr_NamespaceRef:
+                        name = &named->data.namespaceRef->name;
+                        break;
+                    default:
+                        break;
+                    }
+                    if (name == NULL)
+                    {
+                        state->parsingFile->errors.Add(ERR_MSG(this->allocator, "nameof() expects a variable, function, type or namespace"));
+                        return option<LinxcExpression>();
+                    }
+                    result.ID = LinxcExpr_Literal;
+                    result.data.literal = string(this->allocator, "\"");
+                    result.data.literal.Append(name->buffer);
+                    result.data.literal.Append("\"");
+                    result.resolvesTo = LinxcTypeReference(LinxcGetPrimitiveType(LinxcPrimitive_u8));
+                    result.resolvesTo.isConst = true;
+                    result.resolvesTo.pointerCount = 1;
+                    return option<LinxcExpression>(result);
+                }
+
+                option<LinxcTypeReference> operandType = operand.resolvesTo.lastType != NULL ? option<LinxcTypeReference>(operand.resolvesTo) : operand.AsTypeReference();
+                if (!operandType.present)
+                {
+                    ERR_MSG msg = ERR_MSG(this->allocator, LinxcTokenIDToString(token.ID));
+                    msg.Append("() expects a type or an expression");
+                    state->parsingFile->errors.Add(msg);
+                    return option<LinxcExpression>();
+                }
+                if (token.ID == Linxc_Keyword_sizeof)
+                {
+                    result.ID = LinxcExpr_Sizeof;
+                    result.data.sizeofCall = operandType.value;
+                    result.resolvesTo = LinxcTypeReference(LinxcGetPrimitiveType(LinxcPrimitive_u64));
+                }
+                else
+                {
+                    //typeof(expression) is a type name, usable wherever one is expected
+                    if (operand.resolvesTo.lastType == NULL)
+                    {
+                        state->parsingFile->errors.Add(ERR_MSG(this->allocator, "typeof() expects an expression, not a type name"));
+                        return option<LinxcExpression>();
+                    }
+                    result.ID = LinxcExpr_TypeRef;
+                    result.data.typeRef = operandType.value;
+                    result.data.typeRef.isConst = false;
+                    result.resolvesTo.lastType = NULL;
+                }
+                return option<LinxcExpression>(result);
+            }
         case Linxc_CharLiteral:
         case Linxc_StringLiteral:
         case Linxc_FloatLiteral:
@@ -935,35 +764,33 @@ option<LinxcExpression> LinxcParser::ParseExpressionPrimary(LinxcParserState *st
                 result.data.literal = token.ToString(this->allocator);
                 result.ID = LinxcExpr_Literal;
 
-                string temp;
+                LinxcPrimitiveID literalType = LinxcPrimitive_None;
                 if (token.ID == Linxc_Keyword_true || token.ID == Linxc_Keyword_false)
                 {
-                    temp = string("bool");
+                    literalType = LinxcPrimitive_bool;
                 }
                 else if (token.ID == Linxc_FloatLiteral)
                 {
-                    temp = string("float");
+                    literalType = LinxcPrimitive_float;
                 }
                 else if (token.ID == Linxc_IntegerLiteral)
                 {
-                    temp = string("i32");
+                    literalType = LinxcPrimitive_i32;
                 }
                 else if (token.ID == Linxc_CharLiteral)
                 {
-                    temp = string("u8");
+                    literalType = LinxcPrimitive_u8;
                 }
                 else if (token.ID == Linxc_StringLiteral)
                 {
-                    temp = string("u8");
+                    literalType = LinxcPrimitive_u8;
                 }
-                LinxcType* resolvesToType = this->globalNamespace.types.Get(temp);
-                result.resolvesTo = LinxcTypeReference(resolvesToType);
+                result.resolvesTo = LinxcTypeReference(LinxcGetPrimitiveType(literalType));
                 if (token.ID == Linxc_StringLiteral)
                 {
                     result.resolvesTo.isConst = true;
                     result.resolvesTo.pointerCount = 1;
                 }
-                temp.deinit();
                 return option<LinxcExpression>(result);
             }
         default:
@@ -1029,8 +856,13 @@ LinxcExpression LinxcParser::ParseExpression(LinxcParserState *state, LinxcExpre
         operatorCall->rightExpr = rhsOpt.value;
         operatorCall->operatorType = op.ID;
 
-        option<LinxcTypeReference> resolvesTo = operatorCall->EvaluatePossible();
-        if (!resolvesTo.present)
+        option<LinxcTypeReference> resolvesTo = operatorCall->EvaluatePossible(&this->operatorIndex);
+        if (!resolvesTo.present && (operatorCall->leftExpr.resolvesTo.IsDependent() || operatorCall->rightExpr.resolvesTo.IsDependent()))
+        {
+            //resolved again once the template is specialized, see LinxcTemplateInstances
+            lhs.resolvesTo = operatorCall->leftExpr.resolvesTo.IsDependent() ? operatorCall->leftExpr.resolvesTo : operatorCall->rightExpr.resolvesTo;
+        }
+        else if (!resolvesTo.present)
         {
             ERR_MSG msg = ERR_MSG(this->allocator, "Type ");
             msg.AppendDeinit(operatorCall->leftExpr.resolvesTo.ToString(&defaultAllocator));
@@ -1058,11 +890,7 @@ option<LinxcExpression> LinxcParser::ParseIdentifier(LinxcParserState *state, op
 
     if (LinxcIsPrimitiveType(token.ID))
     {
-        LinxcType *type = this->globalNamespace.types.Get(identifierName);
-        LinxcTypeReference reference;
-        reference.isConst = false;
-        reference.lastType = type;
-        reference.templateArgs = collections::Array<LinxcTypeReference>();
+        LinxcTypeReference reference = LinxcTypeReference(LinxcGetPrimitiveType(LinxcPrimitiveFromToken(token.ID)));
 
         result.ID = LinxcExpr_TypeRef;
         result.data.typeRef = reference;
@@ -1097,44 +925,35 @@ option<LinxcExpression> LinxcParser::ParseIdentifier(LinxcParserState *state, op
                 LinxcNamespace* toCheck = state->currentNamespace;
                 while (toCheck != NULL)
                 {
-                    LinxcFunc* asFunction = toCheck->functions.Get(identifierName);
-                    if (asFunction != NULL)
-                    {
-                        result.ID = LinxcExpr_FunctionRef;
-                        result.data.functionRef = asFunction;
-                        result.resolvesTo = asFunction->returnType.AsTypeReference().value;
-                    }
-                    else
+                    LinxcSymbol *symbol = toCheck->symbols.Find(identifierName);
+                    if (symbol != NULL)
                     {
-                        LinxcVar* asVar = toCheck->variables.Get(identifierName);
-                        if (asVar != NULL)
-                        {
-                            result.ID = LinxcExpr_Variable;
-                            result.data.variable = asVar;
-                            //this is guaranteed to be present as a variable would only have a typename-resolveable expression as it's type
-                            result.resolvesTo = asVar->type.AsTypeReference().value;
-                            result.resolvesTo.isConst = asVar->isConst;
-                        }
-                        else
+                        switch (symbol->kind)
                         {
-                            LinxcType* asType = toCheck->types.Get(identifierName);
-                            if (asType != NULL)
-                            {
+                            case LinxcSymbol_Func:
+                                result.ID = LinxcExpr_FunctionRef;
+                                result.data.functionRef = symbol->data.function;
+                                result.resolvesTo = symbol->data.function->returnType.AsTypeReference().value;
+                                break;
+                            case LinxcSymbol_Var:
+                                result.ID = LinxcExpr_Variable;
+                                result.data.variable = symbol->data.variable;
+                                //this is guaranteed to be present as a variable would only have a typename-resolveable expression as it's type
+                                result.resolvesTo = symbol->data.variable->type.AsTypeReference().value;
+                                result.resolvesTo.isConst = symbol->data.variable->isConst;
+                                break;
+                            case LinxcSymbol_Type:
                                 result.ID = LinxcExpr_TypeRef;
-                                result.data.typeRef = asType;
+                                result.data.typeRef = symbol->data.type;
                                 result.resolvesTo.lastType = NULL;
-                            }
-                            else
-                            {
-                                LinxcNamespace* asNamespace = toCheck->subNamespaces.Get(identifierName);
-                                if (asNamespace != NULL)
-                                {
-                                    result.ID = LinxcExpr_NamespaceRef;
-                                    
-                                    result.data.namespaceRef = asNamespace;
-                                    result.resolvesTo.lastType = NULL;
-                                }
-                            }
+                                break;
+                            case LinxcSymbol_Namespace:
+                                result.ID = LinxcExpr_NamespaceRef;
+                                result.data.namespaceRef = symbol->data.namespaceRef;
+                                result.resolvesTo.lastType = NULL;
+                                break;
+                            default:
+                                break;
                         }
                     }
 
@@ -1170,6 +989,15 @@ option<LinxcExpression> LinxcParser::ParseIdentifier(LinxcParserState *state, op
                                 result.data.typeRef = asType;
                                 result.resolvesTo.lastType = NULL;
                             }
+                            for (usize i = 0; i < typeCheck->templateParams.length; i++)
+                            {
+                                if (typeCheck->templateParams.data[i].name == identifierName.buffer)
+                                {
+                                    result.ID = LinxcExpr_TypeRef;
+                                    result.data.typeRef = &typeCheck->templateParams.data[i];
+                                    result.resolvesTo.lastType = NULL;
+                                }
+                            }
                         }
                     }
 
@@ -1181,32 +1009,29 @@ option<LinxcExpression> LinxcParser::ParseIdentifier(LinxcParserState *state, op
         {
             LinxcNamespace *toCheck = parentScopeOverride.value.data.namespaceRef;
             //only need to check immediate parent scope's namespace
-            LinxcFunc *asFunction = toCheck->functions.Get(identifierName);
-            if (asFunction != NULL)
-            {
-                result.ID = LinxcExpr_FunctionRef;
-                result.data.functionRef = asFunction;
-                result.resolvesTo = asFunction->returnType.AsTypeReference().value;
-            }
-            else
+            LinxcSymbol *symbol = toCheck->symbols.Find(identifierName);
+            if (symbol != NULL)
             {
-                LinxcVar *asVar = toCheck->variables.Get(identifierName);
-                if (asVar != NULL)
-                {
-                    result.ID = LinxcExpr_Variable;
-                    result.data.variable = asVar;
-                    result.resolvesTo = asVar->type.AsTypeReference().value;
-                    result.resolvesTo.isConst = asVar->isConst;
-                }
-                else
+                switch (symbol->kind)
                 {
-                    LinxcType *asType = toCheck->types.Get(identifierName);
-                    if (asType != NULL)
-                    {
+                    case LinxcSymbol_Func:
+                        result.ID = LinxcExpr_FunctionRef;
+                        result.data.functionRef = symbol->data.function;
+                        result.resolvesTo = symbol->data.function->returnType.AsTypeReference().value;
+                        break;
+                    case LinxcSymbol_Var:
+                        result.ID = LinxcExpr_Variable;
+                        result.data.variable = symbol->data.variable;
+                        result.resolvesTo = symbol->data.variable->type.AsTypeReference().value;
+                        result.resolvesTo.isConst = symbol->data.variable->isConst;
+                        break;
+                    case LinxcSymbol_Type:
                         result.ID = LinxcExpr_TypeRef;
-                        result.data.typeRef = asType;
+                        result.data.typeRef = symbol->data.type;
                         result.resolvesTo.lastType = NULL;
-                    }
+                        break;
+                    default:
+                        break;
                 }
             }
         }
@@ -1252,7 +1077,18 @@ option<LinxcExpression> LinxcParser::ParseIdentifier(LinxcParserState *state, op
             }
         }
     }
-    if (result.ID == LinxcExpr_TypeRef)
+    if (result.ID == LinxcExpr_TypeRef && result.data.typeRef.lastType->templateArgs.count > 0 && state->tokenizer->PeekNextUntilValid().ID == Linxc_AngleBracketLeft)
+    {
+        option<LinxcTypeReference> specialization = this->ParseTemplateSpecialization(state, result.data.typeRef.lastType);
+        if (!specialization.present)
+        {
+            identifierName.deinit();
+            return option<LinxcExpression>();
+        }
+        result.data.typeRef = specialization.value;
+    }
+    //pointers after a >> belong to the enclosing specialization
+    if (result.ID == LinxcExpr_TypeRef && state->pendingTemplateCloses == 0)
     {
         while (state->tokenizer->PeekNextUntilValid().ID == Linxc_Asterisk)
         {
@@ -1268,6 +1104,99 @@ option<LinxcExpression> LinxcParser::ParseIdentifier(LinxcParserState *state, op
     }
     return option<LinxcExpression>(result);
 }
+option<LinxcTypeReference> LinxcParser::ParseTemplateSpecialization(LinxcParserState *state, LinxcType *templateType)
+{
+    collections::vector<ERR_MSG> *errors = &state->parsingFile->errors;
+    state->tokenizer->NextUntilValid();
+
+    collections::vector<LinxcTypeReference> args = collections::vector<LinxcTypeReference>(&defaultAllocator);
+    bool closed = false;
+    while (!closed)
+    {
+        option<LinxcExpression> primary = this->ParseExpressionPrimary(state);
+        if (!primary.present)
+        {
+            break;
+        }
+        //only scope resolution binds tighter than the closing >
+        LinxcExpression argExpr = this->ParseExpression(state, primary.value, GetPrecedence(Linxc_ColonColon));
+        option<LinxcTypeReference> arg = argExpr.resolvesTo.lastType == NULL ? argExpr.AsTypeReference() : option<LinxcTypeReference>();
+        if (!arg.present || arg.value.lastType == NULL)
+        {
+            errors->Add(ERR_MSG(this->allocator, "Template arguments may only be type names"));
+            break;
+        }
+        //specializations are keyed by type and pointer count alone
+        arg.value.isConst = false;
+        args.Add(arg.value);
+
+        if (state->pendingTemplateCloses > 0)
+        {
+            //closed by the >> that ended a nested specialization
+            state->pendingTemplateCloses -= 1;
+            closed = true;
+            break;
+        }
+        LinxcToken next = state->tokenizer->NextUntilValid();
+        if (next.ID == Linxc_AngleBracketRight)
+        {
+            closed = true;
+        }
+        else if (next.ID == Linxc_AngleBracketAngleBracketRight)
+        {
+            state->pendingTemplateCloses += 1;
+            closed = true;
+        }
+        else if (next.ID != Linxc_Comma)
+        {
+            errors->Add(ERR_MSG(this->allocator, "Expected , or > after template argument"));
+            break;
+        }
+    }
+    if (!closed)
+    {
+        args.deinit();
+        return option<LinxcTypeReference>();
+    }
+    if (args.count != templateType->templateArgs.count)
+    {
+        ERR_MSG msg = ERR_MSG(this->allocator, "Template ");
+        msg.Append(templateType->GetFullName(&defaultAllocator));
+        msg.Append(" expects ");
+        msg.Append((u64)templateType->templateArgs.count);
+        msg.Append(" type arguments, provided ");
+        msg.Append(args.count);
+        errors->Add(msg);
+        args.deinit();
+        return option<LinxcTypeReference>();
+    }
+
+    for (LinxcType *enclosing = state->parentType; enclosing != NULL; enclosing = enclosing->parentType)
+    {
+        if (enclosing != templateType)
+        {
+            continue;
+        }
+        //within its own declaration, a template can only name itself, as it is incomplete until the closing }
+        bool namesItself = true;
+        for (usize i = 0; i < args.count; i++)
+        {
+            namesItself = namesItself && args.ptr[i].lastType == &templateType->templateParams.data[i] && args.ptr[i].pointerCount == 0;
+        }
+        args.deinit();
+        if (!namesItself)
+        {
+            errors->Add(ERR_MSG(this->allocator, "A template cannot be specialized within its own declaration"));
+            return option<LinxcTypeReference>();
+        }
+        return option<LinxcTypeReference>(LinxcTypeReference(templateType));
+    }
+
+    collections::Array<LinxcTypeReference> argsArray = collections::Array<LinxcTypeReference>(&defaultAllocator, args.ptr, args.count);
+    LinxcType *instance = this->templateInstances.Instantiate(&this->typeTable, &this->operatorIndex, templateType, argsArray);
+    args.deinit();
+    return option<LinxcTypeReference>(LinxcTypeReference(instance));
+}
 
 collections::Array<LinxcVar> LinxcParser::ParseFunctionArgs(LinxcParserState *state, u32* necessaryArguments)
 {
@@ -1285,6 +1214,7 @@ collections::Array<LinxcVar> LinxcParser::ParseFunctionArgs(LinxcParserState *st
     bool foundEllipsis = false;
 
     bool isConst = false;
+    u32 attributes = LinxcAttribute_None;
 
     while (true)
     {
@@ -1295,6 +1225,16 @@ collections::Array<LinxcVar> LinxcParser::ParseFunctionArgs(LinxcParserState *st
             state->tokenizer->NextUntilValid();
             continue;
         }
+        else if (peekNext.ID == Linxc_Identifier)
+        {
+            LinxcAttribute attribute = LinxcAttributeFromName(peekNext.tokenizer->buffer + peekNext.start, peekNext.end - peekNext.start);
+            if (attribute != LinxcAttribute_None)
+            {
+                attributes |= attribute;
+                state->tokenizer->NextUntilValid();
+                continue;
+            }
+        }
         else if (peekNext.ID == Linxc_Ellipsis)
         {
             state->tokenizer->NextUntilValid();
@@ -1346,6 +1286,8 @@ collections::Array<LinxcVar> LinxcParser::ParseFunctionArgs(LinxcParserState *st
             string varName = varNameToken.ToString(this->allocator);
             LinxcVar var = LinxcVar(varName, typeExpression, option<LinxcExpression>());
             var.isConst = typeExpression.resolvesTo.isConst;
+            var.attributes = attributes;
+            attributes = LinxcAttribute_None;
             *necessaryArguments = *necessaryArguments + 1;
 
             LinxcToken next = state->tokenizer->NextUntilValid();
@@ -1427,6 +1369,8 @@ option<collections::vector<LinxcStatement>> LinxcParser::ParseCompoundStmt(Linxc
     LinxcTokenizer* tokenizer = state->tokenizer;
 
     bool nextIsConst = false;
+    u32 nextAttributes = LinxcAttribute_None;
+    collections::vector<string> nextTemplateArgs = collections::vector<string>(this->allocator);
     while (true)
     {
         bool toBreak = false;
@@ -1518,37 +1462,77 @@ option<collections::vector<LinxcStatement>> LinxcParser::ParseCompoundStmt(Linxc
             //20/11/2023
         }
         break;
-        //Linxc expects <name> to be after struct keyword. There are no typedef struct {} <name> here.
-        case Linxc_Keyword_namespace:
+        case Linxc_Keyword_template:
         {
             if (isComment)
             {
                 continue;
             }
-            if (nextIsConst)
-            {
-                errors->Add(ERR_MSG(this->allocator, "Cannot declare a namespace as const"));
-                nextIsConst = false;
-            }
-
-            LinxcToken namespaceName = tokenizer->Next();
-
-            if (namespaceName.ID != Linxc_Identifier)
+            if (tokenizer->NextUntilValid().ID != Linxc_AngleBracketLeft)
             {
-                errors->Add(ERR_MSG(this->allocator, "Expected a valid namespace name after namespace keyword!"));
+                errors->Add(ERR_MSG(this->allocator, "Expected < after template keyword"));
+                errorSkipUntilSemicolon = true;
+                break;
             }
-            else
+            while (true)
             {
-                string namespaceNameStrTemp = namespaceName.ToString(&defaultAllocator);
-                LinxcNamespace* thisNamespace = state->currentNamespace->subNamespaces.Get(namespaceNameStrTemp);
+                LinxcToken typenameToken = tokenizer->NextUntilValid();
+                LinxcToken argName = tokenizer->NextUntilValid();
+                if (typenameToken.ID != Linxc_Keyword_typename || argName.ID != Linxc_Identifier)
+                {
+                    errors->Add(ERR_MSG(this->allocator, "Expected typename and a name for each template argument. Templates may only take types as arguments"));
+                    errorSkipUntilSemicolon = true;
+                    break;
+                }
+                nextTemplateArgs.Add(argName.ToString(this->allocator));
+                LinxcToken next = tokenizer->NextUntilValid();
+                if (next.ID == Linxc_AngleBracketRight)
+                {
+                    break;
+                }
+                else if (next.ID != Linxc_Comma)
+                {
+                    errors->Add(ERR_MSG(this->allocator, "Expected , or > after template argument"));
+                    errorSkipUntilSemicolon = true;
+                    break;
+                }
+            }
+            if (!errorSkipUntilSemicolon && tokenizer->PeekNextUntilValid().ID != Linxc_Keyword_struct)
+            {
+                errors->Add(ERR_MSG(this->allocator, "Only structs may be templates"));
+            }
+        }
+        break;
+        //Linxc expects <name> to be after struct keyword. There are no typedef struct {} <name> here.
+        case Linxc_Keyword_namespace:
+        {
+            if (isComment)
+            {
+                continue;
+            }
+            if (nextIsConst)
+            {
+                errors->Add(ERR_MSG(this->allocator, "Cannot declare a namespace as const"));
+                nextIsConst = false;
+            }
+
+            LinxcToken namespaceName = tokenizer->Next();
+
+            if (namespaceName.ID != Linxc_Identifier)
+            {
+                errors->Add(ERR_MSG(this->allocator, "Expected a valid namespace name after namespace keyword!"));
+            }
+            else
+            {
+                string namespaceNameStrTemp = namespaceName.ToString(&defaultAllocator);
+                LinxcNamespace* thisNamespace = state->currentNamespace->FindNamespace(namespaceNameStrTemp);
 
                 if (thisNamespace == NULL)
                 {
                     string namespaceNameStr = namespaceName.ToString(this->allocator);
                     LinxcNamespace newNamespace = LinxcNamespace(this->allocator, namespaceNameStr);
                     newNamespace.parentNamespace = state->currentNamespace;
-                    state->currentNamespace->subNamespaces.Add(namespaceNameStr, newNamespace);
-                    thisNamespace = state->currentNamespace->subNamespaces.Get(namespaceNameStr);
+                    thisNamespace = state->currentNamespace->AddNamespace(newNamespace);
                 }
 
                 LinxcToken next = tokenizer->PeekNextUntilValid();
@@ -1606,6 +1590,24 @@ option<collections::vector<LinxcStatement>> LinxcParser::ParseCompoundStmt(Linxc
             {
                 //declare new struct
                 LinxcType type = LinxcType(allocator, structName.ToString(allocator), state->currentNamespace, state->parentType);
+                type.ID = this->typeTable.NewTypeID();
+                type.attributes = nextAttributes;
+                nextAttributes = LinxcAttribute_None;
+                if (nextTemplateArgs.count > 0)
+                {
+                    if (state->parentType != NULL)
+                    {
+                        //specializations are registered in the template's namespace, which a subtype does not have to itself
+                        errors->Add(ERR_MSG(this->allocator, "Templates may only be declared within a namespace"));
+                        nextTemplateArgs.Clear();
+                    }
+                    else
+                    {
+                        type.templateArgs = nextTemplateArgs;
+                        type.isDependent = true;
+                        nextTemplateArgs = collections::vector<string>(this->allocator);
+                    }
+                }
 
                 LinxcToken next = tokenizer->PeekNextUntilValid();
                 if (next.ID != Linxc_LBrace)
@@ -1624,8 +1626,19 @@ option<collections::vector<LinxcStatement>> LinxcParser::ParseCompoundStmt(Linxc
                 }
                 else
                 {
-                    state->currentNamespace->types.Add(type.name, type);
-                    ptr = state->currentNamespace->types.Get(type.name);
+                    ptr = state->currentNamespace->AddType(type);
+                }
+                if (ptr->templateArgs.count > 0)
+                {
+                    LinxcType *params = (LinxcType*)this->allocator->Allocate(sizeof(LinxcType) * ptr->templateArgs.count);
+                    for (usize i = 0; i < ptr->templateArgs.count; i++)
+                    {
+                        params[i] = LinxcType(this->allocator, *ptr->templateArgs.Get(i), ptr->typeNamespace, NULL);
+                        params[i].ID = this->typeTable.NewTypeID();
+                        params[i].templateParamIndex = (i32)i;
+                        params[i].isDependent = true;
+                    }
+                    ptr->templateParams = collections::Array<LinxcType>(this->allocator, params, ptr->templateArgs.count);
                 }
 
                 LinxcParserState nextState = LinxcParserState(state->parser, state->parsingFile, state->tokenizer, LinxcEndOn_RBrace, false, state->parsingLinxci);
@@ -1668,6 +1681,7 @@ option<collections::vector<LinxcStatement>> LinxcParser::ParseCompoundStmt(Linxc
         case Linxc_Keyword_char:
         case Linxc_Keyword_bool:
         case Linxc_Keyword_void:
+        case Linxc_Keyword_typeof:
         //for *varType = 5;
         //no other modifier is able to be used in this context
         case Linxc_Asterisk:
@@ -1677,6 +1691,15 @@ option<collections::vector<LinxcStatement>> LinxcParser::ParseCompoundStmt(Linxc
             {
                 continue;
             }
+            if (token.ID == Linxc_Identifier)
+            {
+                LinxcAttribute attribute = LinxcAttributeFromName(token.tokenizer->buffer + token.start, token.end - token.start);
+                if (attribute != LinxcAttribute_None)
+                {
+                    nextAttributes |= attribute;
+                    break;
+                }
+            }
             //move backwards
             tokenizer->Back();
 
@@ -1708,7 +1731,30 @@ option<collections::vector<LinxcStatement>> LinxcParser::ParseCompoundStmt(Linxc
                         break;
                     }
 
+                    //operator overloads are declared within the struct they operate on, as ReturnType operator+(OtherType other)
+                    LinxcTokenID overloadedOperator = Linxc_Invalid;
+                    if (state->parentType != NULL && identifier.end - identifier.start == 8 && strncmp(identifier.tokenizer->buffer + identifier.start, "operator", 8) == 0)
+                    {
+                        LinxcToken operatorToken = tokenizer->NextUntilValid();
+                        if (GetOperatorFuncName(operatorToken.ID) == NULL)
+                        {
+                            ERR_MSG error = ERR_MSG(this->allocator, "Operator ");
+                            error.AppendDeinit(operatorToken.ToString(&defaultAllocator));
+                            error.Append(" cannot be overloaded");
+                            errors->Add(error);
+                            toBreak = true;
+                            break;
+                        }
+                        overloadedOperator = operatorToken.ID;
+                    }
+
                     LinxcToken next = tokenizer->NextUntilValid();
+                    if (overloadedOperator != Linxc_Invalid && next.ID != Linxc_LParen)
+                    {
+                        errors->Add(ERR_MSG(this->allocator, "Expected ( after operator"));
+                        toBreak = true;
+                        break;
+                    }
                     if (next.ID == Linxc_Semicolon || next.ID == Linxc_Equal)
                     {
                         option<LinxcExpression> defaultValue;
@@ -1729,6 +1775,8 @@ option<collections::vector<LinxcStatement>> LinxcParser::ParseCompoundStmt(Linxc
                         {
                             varDecl.isConst = true;
                         }
+                        varDecl.attributes = nextAttributes;
+                        nextAttributes = LinxcAttribute_None;
 
                         if (defaultValue.present)
                         {
@@ -1736,7 +1784,7 @@ option<collections::vector<LinxcStatement>> LinxcParser::ParseCompoundStmt(Linxc
                             if (!CanAssign(expectedType, defaultValue.value.resolvesTo))
                             {
                                 ERR_MSG msg = ERR_MSG(this->allocator, "Variable's initial value is not of the same type as the variable itself, and no implicit cast was found.");
-                                if (defaultValue.value.resolvesTo.CanCastTo(expectedType, false))
+                                if (defaultValue.value.resolvesTo.CanCastTo(expectedType, false, &this->operatorIndex))
                                 {
                                     msg.Append(" An explicit cast is required.");
                                 }
@@ -1760,8 +1808,7 @@ option<collections::vector<LinxcStatement>> LinxcParser::ParseCompoundStmt(Linxc
                             }
                             else //else add to namespace
                             {
-                                state->currentNamespace->variables.Add(varDecl.name, varDecl);
-                                ptr = state->currentNamespace->variables.Get(varDecl.name);
+                                ptr = state->currentNamespace->AddVar(varDecl);
 
                                 state->parsingFile->definedVars.Add(ptr);
                             }
@@ -1810,9 +1857,27 @@ option<collections::vector<LinxcStatement>> LinxcParser::ParseCompoundStmt(Linxc
                         }
                         else tokenizer->NextUntilValid();
 
-                        LinxcFunc newFunc = LinxcFunc(identifier.ToString(this->allocator), expr);
+                        string funcName;
+                        if (overloadedOperator != Linxc_Invalid)
+                        {
+                            funcName = string(this->allocator, "operator");
+                            funcName.Append(GetOperatorFuncName(overloadedOperator));
+                            if (args.length != 1)
+                            {
+                                errors->Add(ERR_MSG(this->allocator, "Operator overloads take exactly one argument, the right side of the operation"));
+                            }
+                            if (state->parentType->isDependent)
+                            {
+                                errors->Add(ERR_MSG(this->allocator, "Templates may not overload operators"));
+                            }
+                        }
+                        else funcName = identifier.ToString(this->allocator);
+
+                        LinxcFunc newFunc = LinxcFunc(funcName, expr);
                         newFunc.arguments = args;
                         newFunc.necessaryArguments = necessaryArgs;
+                        newFunc.attributes = nextAttributes;
+                        nextAttributes = LinxcAttribute_None;
                         if (state->parentType != NULL)
                         {
                             newFunc.methodOf = state->parentType;
@@ -1824,15 +1889,31 @@ option<collections::vector<LinxcStatement>> LinxcParser::ParseCompoundStmt(Linxc
 
                         LinxcFunc* ptr = NULL;
 
-                        if (state->parentType != NULL)
+                        if (overloadedOperator != Linxc_Invalid)
+                        {
+                            //kept out of the type's methods, as it is only ever called through the operator and is defined alongside the type
+                            LinxcOperatorFunc *operatorFunc = (LinxcOperatorFunc*)this->allocator->Allocate(sizeof(LinxcOperatorFunc));
+                            operatorFunc->operatorOverride.ID = LinxcOverloadIs_Operator;
+                            operatorFunc->operatorOverride.implicit = false;
+                            operatorFunc->operatorOverride.op = overloadedOperator;
+                            operatorFunc->operatorOverride.myType = LinxcTypeReference(state->parentType);
+                            operatorFunc->operatorOverride.otherType = LinxcTypeReference();
+                            operatorFunc->function = newFunc;
+                            ptr = &operatorFunc->function;
+                            if (args.length == 1 && !state->parentType->isDependent)
+                            {
+                                operatorFunc->operatorOverride.otherType = args.data[0].type.AsTypeReference().value;
+                                this->operatorIndex.Add(operatorFunc);
+                            }
+                        }
+                        else if (state->parentType != NULL)
                         {
                             state->parentType->functions.Add(newFunc);
                             ptr = state->parentType->functions.Get(state->parentType->functions.count - 1);
                         }
                         else
                         {
-                            state->currentNamespace->functions.Add(newFunc.name, newFunc);
-                            ptr = state->currentNamespace->functions.Get(newFunc.name);
+                            ptr = state->currentNamespace->AddFunction(newFunc);
                         }
 
                         LinxcParserState nextState = LinxcParserState(state->parser, state->parsingFile, state->tokenizer, LinxcEndOn_RBrace, false, state->parsingLinxci);
@@ -1872,7 +1953,11 @@ option<collections::vector<LinxcStatement>> LinxcParser::ParseCompoundStmt(Linxc
                             ptr->body = funcBody.value;
                         }
 
-                        state->parsingFile->definedFuncs.Add(ptr);
+                        //operator overloads are transpiled with their type instead
+                        if (overloadedOperator == Linxc_Invalid)
+                        {
+                            state->parsingFile->definedFuncs.Add(ptr);
+                        }
 
                         LinxcStatement stmt;
                         stmt.data.funcDeclaration = ptr;
@@ -1890,6 +1975,11 @@ option<collections::vector<LinxcStatement>> LinxcParser::ParseCompoundStmt(Linxc
                         errors->Add(ERR_MSG(this->allocator, "Cannot declare an expression as const"));
                         nextIsConst = false;
                     }
+                    if (nextAttributes != LinxcAttribute_None)
+                    {
+                        errors->Add(ERR_MSG(this->allocator, "Attributes may only be applied to declarations"));
+                        nextAttributes = LinxcAttribute_None;
+                    }
                     if (state->currentFunction != NULL)
                     {
                         LinxcStatement stmt;
@@ -1997,259 +2087,1587 @@ option<collections::vector<LinxcStatement>> LinxcParser::ParseCompoundStmt(Linxc
             break;
         }
     }
+    nextTemplateArgs.deinit();
     return option<collections::vector<LinxcStatement>>(result);
 }
 
 void LinxcParser::TranspileFile(LinxcParsedFile* parsedFile, const char* outputPathC, const char* outputPathH)
 {
-    FILE* fs;
-    if (fopen_s(&fs, outputPathH, "w") == 0)
+    LinxcWriter writerC = LinxcWriter(&defaultAllocator, 4096);
+    LinxcWriter writerH = LinxcWriter(&defaultAllocator, 4096);
+
+    this->TranspileFile(parsedFile, &writerC, &writerH);
+
+    writerH.WriteToFile(outputPathH);
+    writerC.WriteToFile(outputPathC);
+
+    writerC.deinit();
+    writerH.deinit();
+}
+void LinxcParser::TranspileFile(LinxcParsedFile* parsedFile, LinxcWriter* writerC, LinxcWriter* writerH)
+{
+    this->TranspileFiles(&parsedFile, 1, writerC, writerH);
+}
+
+static bool LinxcIsLinxcInclude(LinxcStatement *stmt)
+{
+    string extension = path::GetExtension(&defaultAllocator, stmt->data.includeStatement.includeString);
+    bool result = extension == ".linxc";
+    extension.deinit();
+    return result;
+}
+static bool LinxcTypeDeclares(LinxcType *declared, LinxcType *type)
+{
+    if (declared == type)
     {
-        //transpile header
-        for (usize i = 0; i < parsedFile->ast.count; i++)
-        {
-            TranspileStatementH(fs, parsedFile->ast.Get(i));
-        }
-        fclose(fs);
+        return true;
     }
-    //transpile source
-    if (fopen_s(&fs, outputPathC, "w") == 0)
+    for (usize i = 0; i < declared->subTypes.count; i++)
     {
-        string swappedExtension = path::SwapExtension(&defaultAllocator, parsedFile->includeName, ".h");
-        fprintf(fs, "#include <%s>\n", swappedExtension.buffer);
-        swappedExtension.deinit();
-        //we only care about functions atm
-        for (usize i = 0; i < parsedFile->definedFuncs.count; i++)
+        if (LinxcTypeDeclares(declared->subTypes.Get(i), type))
         {
-            LinxcFunc* func = parsedFile->definedFuncs.ptr[i];
-            this->TranspileFunc(fs, func);
-            fprintf(fs, "\n{\n");
-            for (usize j = 0; j < func->body.count; j++)
-            {
-                this->TranspileStatementC(fs, func->body.Get(j));
-                fprintf(fs, ";\n");
-            }
-            fprintf(fs, "}\n");
+            return true;
         }
-        fclose(fs);
     }
+    return false;
 }
-void LinxcParser::TranspileStatementH(FILE* fs, LinxcStatement* stmt)
+//Returns whether type is declared by one of the statements in body, including within namespaces and as a subtype
+static bool LinxcBodyDeclares(collections::vector<LinxcStatement> *body, LinxcType *type)
 {
-    if (stmt->ID == LinxcStmt_Include)
+    for (usize i = 0; i < body->count; i++)
     {
-        string includeName = stmt->data.includeStatement.includeString;
-        string extension = path::GetExtension(&defaultAllocator, includeName);
-        if (extension == ".linxc")
-        {
-            includeName = path::SwapExtension(&defaultAllocator, includeName, ".h");
-            //we only set the above to true here as before, we are just referencing the includeName as part of the include
-            //statement. If we deinited that, we would have modified the statement in the AST
-        }
-
-        //make sure no harpy brain programmer uses '\' to specify include paths 
-        string replaced = ReplaceChar(&defaultAllocator, includeName, '\\', '/');
-        fprintf(fs, "#include <%s>\n", includeName.buffer);
-        replaced.deinit();
-
-        if (includeName == "Linxc.h")
+        LinxcStatement *stmt = body->Get(i);
+        if (stmt->ID == LinxcStmt_TypeDecl && LinxcTypeDeclares(stmt->data.typeDeclaration, type))
         {
-            fprintf(fs, "#include <stdbool.h>\n");
+            return true;
         }
-
-        if (extension == ".linxc")
+        else if (stmt->ID == LinxcStmt_Namespace && LinxcBodyDeclares(&stmt->data.namespaceScope.body, type))
         {
-            includeName.deinit();
+            return true;
         }
-        extension.deinit();
     }
-    else if (stmt->ID == LinxcStmt_Namespace)
+    return false;
+}
+static void LinxcAddTypeUse(collections::vector<LinxcType*> *uses, LinxcExpression *typeExpr)
+{
+    option<LinxcTypeReference> typeRef = typeExpr->AsTypeReference();
+    if (!typeRef.present || typeRef.value.lastType == NULL || typeRef.value.lastType->primitiveID != LinxcPrimitive_None)
     {
-        //dont need to do any funny state incrementing here
-        for (usize i = 0; i < stmt->data.namespaceScope.body.count; i++)
+        return;
+    }
+    for (usize i = 0; i < uses->count; i++)
+    {
+        if (uses->ptr[i] == typeRef.value.lastType)
         {
-            TranspileStatementH(fs, stmt->data.namespaceScope.body.Get(i));
+            return;
         }
     }
-    else if (stmt->ID == LinxcStmt_TypeDecl)
+    uses->Add(typeRef.value.lastType);
+}
+//Collects the types a header uses by value into completeUses (as C needs their full definition),
+//and every other type it mentions into incompleteUses (as a forward declaration suffices)
+static void LinxcCollectHeaderTypeUses(collections::vector<LinxcStatement> *body, collections::vector<LinxcType*> *completeUses, collections::vector<LinxcType*> *incompleteUses)
+{
+    for (usize i = 0; i < body->count; i++)
     {
-        fprintf(fs, "typedef struct {\n");
-        string typeName = stmt->data.typeDeclaration->GetCName(&defaultAllocator);
-        for (usize i = 0; i < stmt->data.typeDeclaration->variables.count; i++)
+        LinxcStatement *stmt = body->Get(i);
+        if (stmt->ID == LinxcStmt_Namespace)
         {
-            fprintf(fs, "   ");
-            this->TranspileVar(fs, stmt->data.typeDeclaration->variables.Get(i));
-            fprintf(fs, ";\n");
+            LinxcCollectHeaderTypeUses(&stmt->data.namespaceScope.body, completeUses, incompleteUses);
         }
-        fprintf(fs, "} %s;\n", typeName.buffer);
-        typeName.deinit();
-
-        for (usize i = 0; i < stmt->data.typeDeclaration->functions.count; i++)
+        else if (stmt->ID == LinxcStmt_TypeDecl)
+        {
+            LinxcType *type = stmt->data.typeDeclaration;
+            for (usize j = 0; j < type->variables.count; j++)
+            {
+                LinxcVar *var = type->variables.Get(j);
+                option<LinxcTypeReference> typeRef = var->type.AsTypeReference();
+                LinxcAddTypeUse(typeRef.present && typeRef.value.pointerCount == 0 ? completeUses : incompleteUses, &var->type);
+            }
+            for (usize j = 0; j < type->functions.count; j++)
+            {
+                LinxcFunc *func = type->functions.Get(j);
+                LinxcAddTypeUse(incompleteUses, &func->returnType);
+                for (usize k = 0; k < func->arguments.length; k++)
+                {
+                    LinxcAddTypeUse(incompleteUses, &func->arguments.data[k].type);
+                }
+            }
+        }
+        else if (stmt->ID == LinxcStmt_VarDecl)
         {
-            this->TranspileFunc(fs, stmt->data.typeDeclaration->functions.Get(i));
-            fprintf(fs, ";\n");
+            LinxcVar *var = stmt->data.varDeclaration;
+            option<LinxcTypeReference> typeRef = var->type.AsTypeReference();
+            LinxcAddTypeUse(typeRef.present && typeRef.value.pointerCount == 0 ? completeUses : incompleteUses, &var->type);
+        }
+        else if (stmt->ID == LinxcStmt_FuncDecl)
+        {
+            LinxcFunc *func = stmt->data.funcDeclaration;
+            //C allows incomplete types in the parameters and return type of a declaration that is not a definition
+            LinxcAddTypeUse(incompleteUses, &func->returnType);
+            for (usize k = 0; k < func->arguments.length; k++)
+            {
+                LinxcAddTypeUse(incompleteUses, &func->arguments.data[k].type);
+            }
         }
     }
-    else if (stmt->ID == LinxcStmt_VarDecl)
+}
+//Adds the arguments of every specialization the header declares to completeUses, as its declarations hold them by value.
+//These include specializations used only within function bodies, as the header is where the source gets them from
+static void LinxcCollectInstanceArgUses(collections::vector<LinxcStatement> *body, collections::vector<LinxcType*> *completeUses)
+{
+    LinxcInstanceUses uses = LinxcInstanceUses(&defaultAllocator);
+    for (usize i = 0; i < body->count; i++)
     {
-        this->TranspileVar(fs, stmt->data.varDeclaration);
+        uses.Collect(body->Get(i));
     }
-    else if (stmt->ID == LinxcStmt_FuncDecl)
+    for (usize i = 0; i < uses.instances.count; i++)
     {
-        this->TranspileFunc(fs, stmt->data.funcDeclaration);
-        fprintf(fs, ";\n");
+        LinxcType *instance = uses.instances.ptr[i];
+        for (usize j = 0; j < instance->instanceArgs.length; j++)
+        {
+            LinxcExpression argExpr = instance->instanceArgs.data[j].lastType->AsExpression();
+            LinxcAddTypeUse(completeUses, &argExpr);
+        }
     }
+    uses.deinit();
 }
-void LinxcParser::TranspileFunc(FILE *fs, LinxcFunc* func)
+//Returns whether body declares a type with a reachable operator overload, which the header defines in full
+static bool LinxcBodyDefinesOperators(collections::vector<LinxcStatement> *body)
 {
-    LinxcTypeReference typeRef = func->returnType.AsTypeReference().value;
-
-    string returnTypeName = typeRef.GetCName(&defaultAllocator);
-    fprintf(fs, "%s ", returnTypeName.buffer);
-    returnTypeName.deinit();
-
-    string funcName = func->GetCName(&defaultAllocator);
-    fprintf(fs, "%s(", funcName.buffer);
-    funcName.deinit();
-
-    //if we are a member function of a struct, the first argument will always be 'this'
-    if (func->methodOf != NULL)
+    for (usize i = 0; i < body->count; i++)
     {
-        string thisTypeName = func->methodOf->GetCName(&defaultAllocator);
-        fprintf(fs, "%s *this", thisTypeName.buffer);
-        if (func->arguments.length > 0)
+        LinxcStatement *stmt = body->Get(i);
+        if (stmt->ID == LinxcStmt_Namespace && LinxcBodyDefinesOperators(&stmt->data.namespaceScope.body))
         {
-            fprintf(fs, ", ");
+            return true;
         }
-    }
-    for (usize i = 0; i < func->arguments.length; i++)
-    {
-        this->TranspileVar(fs, &func->arguments.data[i]);
-        if (i < func->arguments.length - 1)
+        if (stmt->ID == LinxcStmt_TypeDecl && stmt->data.typeDeclaration->isReachable)
         {
-            fprintf(fs, ", ");
+            LinxcOperatorOverloads *overloads = &stmt->data.typeDeclaration->operatorOverloads;
+            for (usize j = 0; j < overloads->entries.count; j++)
+            {
+                if (overloads->entries.ptr[j].func->function.isReachable)
+                {
+                    return true;
+                }
+            }
         }
     }
-
-    fprintf(fs, ")");
+    return false;
 }
-void LinxcParser::TranspileExpr(FILE* fs, LinxcExpression* expr)
+LinxcParsedFile *LinxcParser::FindIncludedFile(LinxcStatement* includeStmt)
 {
-    switch (expr->ID)
+    if (includeStmt->data.includeStatement.includedFile != NULL)
     {
-    case LinxcExpr_None:
-        break;
-    case LinxcExpr_Literal:
+        return includeStmt->data.includeStatement.includedFile;
+    }
+    return this->parsedFiles.Get(includeStmt->data.includeStatement.includeString);
+}
+bool LinxcParser::HeaderNeedsFullInclude(LinxcParsedFile* file, LinxcStatement* includeStmt)
+{
+    LinxcParsedFile *includedFile = this->FindIncludedFile(includeStmt);
+    if (!LinxcIsLinxcInclude(includeStmt) || includedFile == NULL)
     {
-        fprintf(fs, "%s", expr->data.literal.buffer);
+        //we can't see into C headers or files we haven't parsed, so keep them
+        return true;
     }
-    break;
-    case LinxcExpr_Variable:
+    if (LinxcBodyDefinesOperators(&file->ast))
     {
-        fprintf(fs, "%s", expr->data.variable->name.buffer);
+        //the bodies of operator overloads may use anything the included file declares
+        return true;
     }
-    break;
-    case LinxcExpr_Modified:
+    collections::vector<LinxcType*> completeUses = collections::vector<LinxcType*>(&defaultAllocator);
+    collections::vector<LinxcType*> incompleteUses = collections::vector<LinxcType*>(&defaultAllocator);
+    LinxcCollectHeaderTypeUses(&file->ast, &completeUses, &incompleteUses);
+    LinxcCollectInstanceArgUses(&file->ast, &completeUses);
+    bool result = false;
+    for (usize i = 0; i < completeUses.count; i++)
     {
-        fprintf(fs, "%s", LinxcTokenIDToString(expr->data.modifiedExpression->modification));
-        this->TranspileExpr(fs, &expr->data.modifiedExpression->expression);
+        if (LinxcBodyDeclares(&includedFile->ast, completeUses.ptr[i]))
+        {
+            result = true;
+            break;
+        }
     }
-    break;
-    case LinxcExpr_FuncCall:
+    incompleteUses.deinit();
+    completeUses.deinit();
+    return result;
+}
+void LinxcParser::TranspileHeader(LinxcWriter* writer, LinxcParsedFile* file)
+{
+    collections::vector<LinxcType*> completeUses = collections::vector<LinxcType*>(&defaultAllocator);
+    collections::vector<LinxcType*> incompleteUses = collections::vector<LinxcType*>(&defaultAllocator);
+    LinxcCollectHeaderTypeUses(&file->ast, &completeUses, &incompleteUses);
+    LinxcInstanceUses emitted = LinxcInstanceUses(&defaultAllocator);
+
+    for (usize i = 0; i < file->ast.count; i++)
     {
-        string name = expr->data.functionCall.func->GetCName(&defaultAllocator);
-        fprintf(fs, "%s(", name.buffer);
-        name.deinit();
-        for (usize i = 0; i < expr->data.functionCall.inputParams.length; i++)
+        LinxcStatement *stmt = file->ast.Get(i);
+        if (stmt->ID != LinxcStmt_Include)
+        {
+            this->TranspileDeclarationH(writer, stmt, &emitted);
+            continue;
+        }
+        if (this->HeaderNeedsFullInclude(file, stmt))
         {
-            this->TranspileExpr(fs, &expr->data.functionCall.inputParams.data[i]);
-            if (i < expr->data.functionCall.inputParams.length - 1)
+            this->TranspileStatementH(writer, stmt);
+            continue;
+        }
+        //the header only mentions types of the included file by pointer or in declarations,
+        //so forward declare those and leave the include itself to the source file
+        LinxcParsedFile *includedFile = this->FindIncludedFile(stmt);
+        for (usize j = 0; j < incompleteUses.count; j++)
+        {
+            if (LinxcBodyDeclares(&includedFile->ast, incompleteUses.ptr[j]))
             {
-                fprintf(fs, ", ");
+                const char *typeName = incompleteUses.ptr[j]->GetCName(this->allocator);
+                writer->Append("typedef struct ");
+                writer->Append(typeName);
+                writer->Append(' ');
+                writer->Append(typeName);
+                writer->Append(";\n");
             }
         }
-        fprintf(fs, "}");
-        //expr->data.functionCall.func->
     }
-    case LinxcExpr_FunctionRef:
+
+    emitted.deinit();
+    incompleteUses.deinit();
+    completeUses.deinit();
+}
+void LinxcParser::TranspileSourceIncludes(LinxcWriter* writer, LinxcParsedFile* file)
+{
+    for (usize i = 0; i < file->ast.count; i++)
     {
-        string name = expr->data.functionRef->GetCName(&defaultAllocator);
-        fprintf(fs, "%s(", name.buffer);
-        name.deinit();
+        LinxcStatement *stmt = file->ast.Get(i);
+        if (stmt->ID == LinxcStmt_Include && !this->HeaderNeedsFullInclude(file, stmt))
+        {
+            this->TranspileStatementH(writer, stmt);
+        }
     }
-    break;
-    case LinxcExpr_OperatorCall:
+}
+//Transpiles var declared extern, without its initializer
+static void LinxcTranspileExternVar(LinxcParser *parser, LinxcWriter* writer, LinxcVar* var)
+{
+    LinxcVar declared = *var;
+    declared.defaultValue = option<LinxcExpression>();
+    writer->Append("extern ");
+    parser->TranspileVar(writer, &declared);
+    writer->Append(";\n");
+}
+void LinxcParser::TranspileFileLocals(LinxcWriter* writer, LinxcParsedFile* file, bool isStatic)
+{
+    for (usize i = 0; i < file->definedVars.count; i++)
     {
-        //when transpiling an operator with a scope resolution operation, we should ignore the
-        //resolution and only transpile the right side until we reach the variable/function/type.
-        //this is so as to prevent duplicate namespace scopes when transpiled to C, as we need
-        //to transpile the variable/function/type as it's complete C friendly name.
-        //If we were to transpile it as is, and make the C friendly name by transpiling scope resolution operators,
-        //variables/functions/types contained in a using'd namespace would be improperly transpiled
-        if (expr->data.operatorCall->operatorType == Linxc_ColonColon)
+        LinxcVar *var = *file->definedVars.Get(i);
+        if (var->isFileLocal && isStatic)
         {
-            this->TranspileExpr(fs, &expr->data.operatorCall->rightExpr);
+            writer->Append("static ");
+            this->TranspileVar(writer, var);
+            writer->Append(";\n");
         }
-        else
+        else if (var->isFileLocal)
         {
-            //todo: Convert custom operators to functions
-            LinxcTokenID opType = expr->data.operatorCall->operatorType;
-            bool writePriority = opType != Linxc_ColonColon && opType != Linxc_Arrow && opType != Linxc_Period && opType != Linxc_Equal;
-            if (writePriority)
-            {
-                fprintf(fs, "(");
-            }
-            this->TranspileExpr(fs, &expr->data.operatorCall->leftExpr);
-            //if not ::, ->, ., yes space
-            if (opType != Linxc_ColonColon && opType != Linxc_Arrow && opType != Linxc_Period)
+            LinxcTranspileExternVar(this, writer, var);
+        }
+    }
+    //prototypes, as definitions may call functions defined after them
+    for (usize i = 0; i < file->definedFuncs.count; i++)
+    {
+        LinxcFunc *func = *file->definedFuncs.Get(i);
+        if (func->isFileLocal && func->isReachable)
+        {
+            if (isStatic)
             {
-                fprintf(fs, " %s ", LinxcTokenIDToString(expr->data.operatorCall->operatorType));
+                writer->Append("static ");
             }
-            //no space
-            else fprintf(fs, "%s", LinxcTokenIDToString(expr->data.operatorCall->operatorType));
-            this->TranspileExpr(fs, &expr->data.operatorCall->rightExpr);
-            if (writePriority)
+            this->TranspileFunc(writer, func);
+            writer->Append(";\n");
+        }
+    }
+}
+
+/// A contiguous slice of one file's output. The header of a file is a single job,
+/// while its function definitions are split into jobs of up to LINXC_TRANSPILE_FUNCS_PER_JOB.
+/// Definitions of template specializations belong to no file, and come from funcs instead.
+struct LinxcTranspileJob
+{
+    LinxcParsedFile *file;
+    LinxcFunc **funcs;
+    bool isHeader;
+    usize funcStart;
+    usize funcEnd;
+    LinxcWriter writer;
+};
+struct LinxcTranspileWorker
+{
+    LinxcParser *parser;
+    LinxcTranspileJob *jobs;
+    usize jobCount;
+    usize firstJob;
+    usize jobStride;
+};
+static void LinxcRunTranspileWorker(void *data)
+{
+    LinxcTranspileWorker *worker = (LinxcTranspileWorker*)data;
+    LinxcParser *parser = worker->parser;
+    for (usize i = worker->firstJob; i < worker->jobCount; i += worker->jobStride)
+    {
+        LinxcTranspileJob *job = &worker->jobs[i];
+        if (job->isHeader)
+        {
+            parser->TranspileHeader(&job->writer, job->file);
+        }
+        else
+        {
+            for (usize j = job->funcStart; j < job->funcEnd; j++)
             {
-                fprintf(fs, ")");
+                LinxcFunc* func = job->funcs[j];
+                //methods of templates are only transpiled through their specializations
+                if (!func->isReachable || (func->methodOf != NULL && func->methodOf->isDependent))
+                {
+                    continue;
+                }
+                parser->TranspileFunc(&job->writer, func);
+                job->writer.Append("\n{\n");
+                for (usize k = 0; k < func->body.count; k++)
+                {
+                    parser->TranspileStatementC(&job->writer, func, func->body.Get(k));
+                    job->writer.Append(";\n");
+                }
+                job->writer.Append("}\n");
             }
         }
     }
-    break;
-    default:
-        break;
-    }
 }
-void LinxcParser::TranspileVar(FILE* fs, LinxcVar* var)
+//Runs every job on parser->transpileThreads workers, returning once all of them are complete
+static void LinxcRunTranspileJobs(LinxcParser *parser, LinxcTranspileJob *jobs, usize jobCount)
 {
-    if (var->isConst)
+    usize threadCount = parser->transpileThreads == 0 ? LinxcHardwareThreadCount() : parser->transpileThreads;
+    if (threadCount > jobCount)
     {
-        fprintf(fs, "const ");
+        threadCount = jobCount;
     }
-    LinxcTypeReference typeRef = var->type.AsTypeReference().value;
-    string fullName = typeRef.GetCName(&defaultAllocator);
-    fprintf(fs, "%s ", fullName.buffer);
-    fullName.deinit();
-    fprintf(fs, "%s", var->name.buffer);
-    if (var->defaultValue.present)
+    if (threadCount <= 1)
+    {
+        LinxcTranspileWorker worker;
+        worker.parser = parser;
+        worker.jobs = jobs;
+        worker.jobCount = jobCount;
+        worker.firstJob = 0;
+        worker.jobStride = 1;
+        LinxcRunTranspileWorker(&worker);
+    }
+    else
     {
-        fprintf(fs, " = "); //temp
-        this->TranspileExpr(fs, &var->defaultValue.value);
+        //jobs are statically interleaved across workers, the calling thread being worker 0
+        LinxcTranspileWorker *workers = (LinxcTranspileWorker*)defaultAllocator.Allocate(sizeof(LinxcTranspileWorker) * threadCount);
+        LinxcThread *threads = (LinxcThread*)defaultAllocator.Allocate(sizeof(LinxcThread) * threadCount);
+        for (usize i = 0; i < threadCount; i++)
+        {
+            workers[i].parser = parser;
+            workers[i].jobs = jobs;
+            workers[i].jobCount = jobCount;
+            workers[i].firstJob = i;
+            workers[i].jobStride = threadCount;
+            threads[i] = LinxcThread();
+        }
+        for (usize i = 1; i < threadCount; i++)
+        {
+            threads[i].Start(&LinxcRunTranspileWorker, &workers[i]);
+        }
+        LinxcRunTranspileWorker(&workers[0]);
+        for (usize i = 1; i < threadCount; i++)
+        {
+            threads[i].Join();
+        }
+        defaultAllocator.Free((void**)&threads);
+        defaultAllocator.Free((void**)&workers);
     }
-    //else fprintf(fs, ";\n");
 }
-void LinxcParser::TranspileStatementC(FILE* fs, LinxcStatement* stmt)
+void LinxcParser::TranspileFiles(LinxcParsedFile** parsedFiles, usize count, LinxcWriter* writersC, LinxcWriter* writersH)
 {
-    if (stmt->ID == LinxcStmt_Expr)
+    this->PrepareTranspile();
+
+    usize jobCount = 0;
+    for (usize i = 0; i < count; i++)
     {
-        this->TranspileExpr(fs, &stmt->data.expression);
+        usize funcCount = parsedFiles[i]->definedFuncs.count;
+        jobCount += 1 + (funcCount + LINXC_TRANSPILE_FUNCS_PER_JOB - 1) / LINXC_TRANSPILE_FUNCS_PER_JOB;
     }
-    else if (stmt->ID == LinxcStmt_Return)
+    LinxcTranspileJob *jobs = (LinxcTranspileJob*)defaultAllocator.Allocate(sizeof(LinxcTranspileJob) * jobCount);
+    usize jobIndex = 0;
+    for (usize i = 0; i < count; i++)
     {
-        fprintf(fs, "return ");
-        this->TranspileExpr(fs, &stmt->data.returnStatement);
+        LinxcTranspileJob headerJob;
+        headerJob.file = parsedFiles[i];
+        headerJob.funcs = NULL;
+        headerJob.isHeader = true;
+        headerJob.funcStart = 0;
+        headerJob.funcEnd = 0;
+        headerJob.writer = LinxcWriter(&defaultAllocator);
+        jobs[jobIndex] = headerJob;
+        jobIndex += 1;
+
+        usize funcCount = parsedFiles[i]->definedFuncs.count;
+        for (usize j = 0; j < funcCount; j += LINXC_TRANSPILE_FUNCS_PER_JOB)
+        {
+            LinxcTranspileJob funcJob;
+            funcJob.file = parsedFiles[i];
+            funcJob.funcs = parsedFiles[i]->definedFuncs.ptr;
+            funcJob.isHeader = false;
+            funcJob.funcStart = j;
+            funcJob.funcEnd = j + LINXC_TRANSPILE_FUNCS_PER_JOB < funcCount ? j + LINXC_TRANSPILE_FUNCS_PER_JOB : funcCount;
+            funcJob.writer = LinxcWriter(&defaultAllocator);
+            jobs[jobIndex] = funcJob;
+            jobIndex += 1;
+        }
     }
-    else if (stmt->ID == LinxcStmt_VarDecl)
+
+    LinxcRunTranspileJobs(this, jobs, jobCount);
+
+    //concatenate in job order so that output is byte-identical to transpiling serially
+    jobIndex = 0;
+    for (usize i = 0; i < count; i++)
     {
-        this->TranspileVar(fs, stmt->data.varDeclaration);
+        LinxcTranspileJob *headerJob = &jobs[jobIndex];
+        writersH[i].Append(headerJob->writer.buffer, headerJob->writer.length);
+        headerJob->writer.deinit();
+        jobIndex += 1;
+
+        string swappedExtension = path::SwapExtension(&defaultAllocator, parsedFiles[i]->includeName, ".h");
+        writersC[i].Append("#include <");
+        writersC[i].Append(swappedExtension.buffer);
+        writersC[i].Append(">\n");
+        swappedExtension.deinit();
+        this->TranspileSourceIncludes(&writersC[i], parsedFiles[i]);
+        this->TranspileFileLocals(&writersC[i], parsedFiles[i], true);
+        this->TranspileGlobalDefinitions(&writersC[i], parsedFiles[i], false);
+        //we only care about functions atm
+        while (jobIndex < jobCount && jobs[jobIndex].file == parsedFiles[i] && !jobs[jobIndex].isHeader)
+        {
+            writersC[i].Append(jobs[jobIndex].writer.buffer, jobs[jobIndex].writer.length);
+            jobs[jobIndex].writer.deinit();
+            jobIndex += 1;
+        }
+    }
+    defaultAllocator.Free((void**)&jobs);
+}
+//Appends file to ordered after every parsed .linxc file it includes, so that declarations always precede their use
+static void LinxcOrderByIncludes(LinxcParser *parser, LinxcParsedFile *file, collections::vector<LinxcParsedFile*> *visited, collections::vector<LinxcParsedFile*> *ordered)
+{
+    for (usize i = 0; i < visited->count; i++)
+    {
+        if (visited->ptr[i] == file)
+        {
+            return;
+        }
+    }
+    visited->Add(file);
+    for (usize i = 0; i < file->ast.count; i++)
+    {
+        LinxcStatement *stmt = file->ast.Get(i);
+        if (stmt->ID != LinxcStmt_Include || !LinxcIsLinxcInclude(stmt))
+        {
+            continue;
+        }
+        LinxcParsedFile *includedFile = parser->FindIncludedFile(stmt);
+        if (includedFile != NULL)
+        {
+            LinxcOrderByIncludes(parser, includedFile, visited, ordered);
+        }
+    }
+    ordered->Add(file);
+}
+//Transpiles every C include of the files in ordered once, in order of first appearance
+static void LinxcTranspileCIncludes(LinxcParser *parser, LinxcWriter *writer, collections::vector<LinxcParsedFile*> *ordered)
+{
+    collections::hashset<string, StringKeys> includedHeaders = collections::hashset<string, StringKeys>(&defaultAllocator);
+    for (usize i = 0; i < ordered->count; i++)
+    {
+        LinxcParsedFile *file = ordered->ptr[i];
+        for (usize j = 0; j < file->ast.count; j++)
+        {
+            LinxcStatement *stmt = file->ast.Get(j);
+            if (stmt->ID == LinxcStmt_Include && !LinxcIsLinxcInclude(stmt) && !includedHeaders.Contains(stmt->data.includeStatement.includeString))
+            {
+                includedHeaders.Add(stmt->data.includeStatement.includeString);
+                parser->TranspileStatementH(writer, stmt);
+            }
+        }
+    }
+    includedHeaders.deinit();
+}
+void LinxcParser::TranspilePrefixHeader(LinxcParsedFile** parsedFiles, usize count, const char* outputDirectory, const char* prefixName)
+{
+    string pathH = string(&defaultAllocator, outputDirectory);
+    pathH.Append("/");
+    pathH.Append(prefixName);
+    pathH.Append(".h");
+
+    LinxcWriter writer = LinxcWriter(&defaultAllocator, 1024);
+    this->TranspilePrefixHeader(&writer, parsedFiles, count);
+    writer.WriteToFile(pathH.buffer);
+
+    //response files, passed to gcc or clang as @file. Both look for pathH.gch when given -include pathH
+    string pathRsp = string(&defaultAllocator, outputDirectory);
+    pathRsp.Append("/");
+    pathRsp.Append(prefixName);
+    pathRsp.Append(".build.rsp");
+    writer.Clear();
+    writer.Append("-x c-header \"");
+    writer.Append(pathH.buffer);
+    writer.Append("\" -o \"");
+    writer.Append(pathH.buffer);
+    writer.Append(".gch\"\n");
+    writer.WriteToFile(pathRsp.buffer);
+    pathRsp.deinit();
+
+    pathRsp = string(&defaultAllocator, outputDirectory);
+    pathRsp.Append("/");
+    pathRsp.Append(prefixName);
+    pathRsp.Append(".use.rsp");
+    writer.Clear();
+    writer.Append("-include \"");
+    writer.Append(pathH.buffer);
+    writer.Append("\"\n");
+    writer.WriteToFile(pathRsp.buffer);
+    pathRsp.deinit();
+
+    writer.deinit();
+    pathH.deinit();
+}
+void LinxcParser::TranspilePrefixHeader(LinxcWriter* writer, LinxcParsedFile** parsedFiles, usize count)
+{
+    collections::vector<LinxcParsedFile*> visited = collections::vector<LinxcParsedFile*>(&defaultAllocator);
+    collections::vector<LinxcParsedFile*> ordered = collections::vector<LinxcParsedFile*>(&defaultAllocator);
+    for (usize i = 0; i < count; i++)
+    {
+        LinxcOrderByIncludes(this, parsedFiles[i], &visited, &ordered);
+    }
+    //only C headers go in: the runtime and libraries change rarely, while generated headers change on every edit
+    //and would invalidate the precompiled header
+    LinxcTranspileCIncludes(this, writer, &ordered);
+    ordered.deinit();
+    visited.deinit();
+}
+void LinxcParser::TranspileAmalgamated(LinxcParsedFile** parsedFiles, usize count, const char* outputDirectory, const char* projectName, usize shardCount)
+{
+    if (shardCount == 0)
+    {
+        shardCount = 1;
+    }
+    LinxcWriter writerH = LinxcWriter(&defaultAllocator, 4096);
+    LinxcWriter *writersC = (LinxcWriter*)defaultAllocator.Allocate(sizeof(LinxcWriter) * shardCount);
+    for (usize i = 0; i < shardCount; i++)
+    {
+        writersC[i] = LinxcWriter(&defaultAllocator, 4096);
+    }
+
+    string basePath = string(&defaultAllocator, outputDirectory);
+    basePath.Append("/");
+    basePath.Append(projectName);
+    string headerName = string(&defaultAllocator, projectName);
+    headerName.Append(".h");
+
+    //a single shard is a self-contained translation unit and needs no header
+    this->TranspileAmalgamated(parsedFiles, count, headerName.buffer, shardCount > 1 ? &writerH : NULL, writersC, shardCount);
+
+    if (shardCount > 1)
+    {
+        string pathH = string(&defaultAllocator, basePath.buffer);
+        pathH.Append(".h");
+        writerH.WriteToFile(pathH.buffer);
+        pathH.deinit();
+    }
+    for (usize i = 0; i < shardCount; i++)
+    {
+        string pathC = string(&defaultAllocator, basePath.buffer);
+        if (shardCount > 1)
+        {
+            pathC.Append((u64)i);
+        }
+        pathC.Append(".c");
+        writersC[i].WriteToFile(pathC.buffer);
+        pathC.deinit();
+        writersC[i].deinit();
+    }
+
+    headerName.deinit();
+    basePath.deinit();
+    defaultAllocator.Free((void**)&writersC);
+    writerH.deinit();
+}
+void LinxcParser::TranspileAmalgamated(LinxcParsedFile** parsedFiles, usize count, const char* headerName, LinxcWriter* writerH, LinxcWriter* writersC, usize shardCount)
+{
+    this->PrepareTranspile();
+
+    collections::vector<LinxcParsedFile*> visited = collections::vector<LinxcParsedFile*>(&defaultAllocator);
+    collections::vector<LinxcParsedFile*> ordered = collections::vector<LinxcParsedFile*>(&defaultAllocator);
+    for (usize i = 0; i < count; i++)
+    {
+        LinxcOrderByIncludes(this, parsedFiles[i], &visited, &ordered);
+    }
+
+    //declarations: every C include once, in order of first appearance, then each file's declarations in include order.
+    //.linxc includes are dropped, as their declarations are already part of the amalgamation
+    LinxcWriter declarations = LinxcWriter(&defaultAllocator, 4096);
+    LinxcTranspileCIncludes(this, &declarations, &ordered);
+    LinxcInstanceUses emitted = LinxcInstanceUses(&defaultAllocator);
+    for (usize i = 0; i < ordered.count; i++)
+    {
+        LinxcParsedFile *file = ordered.ptr[i];
+        for (usize j = 0; j < file->ast.count; j++)
+        {
+            LinxcStatement *stmt = file->ast.Get(j);
+            if (stmt->ID != LinxcStmt_Include)
+            {
+                this->TranspileDeclarationH(&declarations, stmt, &emitted);
+            }
+        }
+        //a file's definitions may be split across shards, in which case its file-local declarations have to stay external,
+        //and its globals are defined by the first shard alone
+        this->TranspileFileLocals(&declarations, file, shardCount == 1);
+        if (shardCount == 1)
+        {
+            this->TranspileGlobalDefinitions(&declarations, file, false);
+        }
+    }
+    //the methods of every specialization used are defined once, after the definitions of the files
+    collections::vector<LinxcFunc*> instanceMethods = collections::vector<LinxcFunc*>(&defaultAllocator);
+    for (usize i = 0; i < emitted.instances.count; i++)
+    {
+        LinxcType *instance = emitted.instances.ptr[i];
+        for (usize j = 0; j < instance->functions.count; j++)
+        {
+            instanceMethods.Add(instance->functions.Get(j));
+        }
+    }
+
+    //definitions: one job per function, so that shards can be balanced by size
+    usize jobCount = instanceMethods.count;
+    for (usize i = 0; i < ordered.count; i++)
+    {
+        jobCount += ordered.ptr[i]->definedFuncs.count;
+    }
+    LinxcTranspileJob *jobs = (LinxcTranspileJob*)defaultAllocator.Allocate(sizeof(LinxcTranspileJob) * (jobCount > 0 ? jobCount : 1));
+    usize jobIndex = 0;
+    for (usize i = 0; i < ordered.count; i++)
+    {
+        for (usize j = 0; j < ordered.ptr[i]->definedFuncs.count; j++)
+        {
+            LinxcTranspileJob funcJob;
+            funcJob.file = ordered.ptr[i];
+            funcJob.funcs = ordered.ptr[i]->definedFuncs.ptr;
+            funcJob.isHeader = false;
+            funcJob.funcStart = j;
+            funcJob.funcEnd = j + 1;
+            funcJob.writer = LinxcWriter(&defaultAllocator);
+            jobs[jobIndex] = funcJob;
+            jobIndex += 1;
+        }
+    }
+    for (usize i = 0; i < instanceMethods.count; i++)
+    {
+        LinxcTranspileJob funcJob;
+        funcJob.file = NULL;
+        funcJob.funcs = instanceMethods.ptr;
+        funcJob.isHeader = false;
+        funcJob.funcStart = i;
+        funcJob.funcEnd = i + 1;
+        funcJob.writer = LinxcWriter(&defaultAllocator);
+        jobs[jobIndex] = funcJob;
+        jobIndex += 1;
+    }
+    LinxcRunTranspileJobs(this, jobs, jobCount);
+
+    usize totalLength = 0;
+    for (usize i = 0; i < jobCount; i++)
+    {
+        totalLength += jobs[i].writer.length;
+    }
+
+    if (writerH != NULL)
+    {
+        writerH->Append(declarations.buffer, declarations.length);
+    }
+    //shards take contiguous runs of definitions, moving on once they reach their share of the total length
+    jobIndex = 0;
+    usize writtenLength = 0;
+    for (usize i = 0; i < shardCount; i++)
+    {
+        if (writerH != NULL)
+        {
+            writersC[i].Append("#include <");
+            writersC[i].Append(headerName);
+            writersC[i].Append(">\n");
+        }
+        else writersC[i].Append(declarations.buffer, declarations.length);
+        if (writerH != NULL && i == 0)
+        {
+            for (usize j = 0; j < ordered.count; j++)
+            {
+                this->TranspileGlobalDefinitions(&writersC[i], ordered.ptr[j], true);
+            }
+        }
+
+        usize shardEnd = totalLength * (i + 1) / shardCount;
+        while (jobIndex < jobCount && (writtenLength < shardEnd || i == shardCount - 1))
+        {
+            writersC[i].Append(jobs[jobIndex].writer.buffer, jobs[jobIndex].writer.length);
+            writtenLength += jobs[jobIndex].writer.length;
+            jobs[jobIndex].writer.deinit();
+            jobIndex += 1;
+        }
+    }
+
+    defaultAllocator.Free((void**)&jobs);
+    instanceMethods.deinit();
+    emitted.deinit();
+    declarations.deinit();
+    ordered.deinit();
+    visited.deinit();
+}
+void LinxcParser::TranspileInstantiations(LinxcParsedFile** parsedFiles, usize count, const char* outputPath)
+{
+    LinxcWriter writer = LinxcWriter(&defaultAllocator, 4096);
+    this->TranspileInstantiations(&writer, parsedFiles, count);
+    writer.WriteToFile(outputPath);
+    writer.deinit();
+}
+void LinxcParser::TranspileInstantiations(LinxcWriter* writer, LinxcParsedFile** parsedFiles, usize count)
+{
+    this->PrepareTranspile();
+
+    collections::vector<LinxcParsedFile*> visited = collections::vector<LinxcParsedFile*>(&defaultAllocator);
+    collections::vector<LinxcParsedFile*> ordered = collections::vector<LinxcParsedFile*>(&defaultAllocator);
+    for (usize i = 0; i < count; i++)
+    {
+        LinxcOrderByIncludes(this, parsedFiles[i], &visited, &ordered);
+    }
+
+    //the headers between them declare every specialization used, and the guards keep each to a single definition
+    LinxcInstanceUses uses = LinxcInstanceUses(&defaultAllocator);
+    for (usize i = 0; i < ordered.count; i++)
+    {
+        LinxcParsedFile *file = ordered.ptr[i];
+        string swappedExtension = path::SwapExtension(&defaultAllocator, file->includeName, ".h");
+        writer->Append("#include <");
+        writer->Append(swappedExtension.buffer);
+        writer->Append(">\n");
+        swappedExtension.deinit();
+        for (usize j = 0; j < file->ast.count; j++)
+        {
+            uses.Collect(file->ast.Get(j));
+        }
+    }
+
+    collections::vector<LinxcFunc*> instanceMethods = collections::vector<LinxcFunc*>(&defaultAllocator);
+    for (usize i = 0; i < uses.instances.count; i++)
+    {
+        LinxcType *instance = uses.instances.ptr[i];
+        for (usize j = 0; j < instance->functions.count; j++)
+        {
+            instanceMethods.Add(instance->functions.Get(j));
+        }
+    }
+    usize jobCount = instanceMethods.count;
+    LinxcTranspileJob *jobs = (LinxcTranspileJob*)defaultAllocator.Allocate(sizeof(LinxcTranspileJob) * (jobCount > 0 ? jobCount : 1));
+    for (usize i = 0; i < jobCount; i++)
+    {
+        LinxcTranspileJob funcJob;
+        funcJob.file = NULL;
+        funcJob.funcs = instanceMethods.ptr;
+        funcJob.isHeader = false;
+        funcJob.funcStart = i;
+        funcJob.funcEnd = i + 1;
+        funcJob.writer = LinxcWriter(&defaultAllocator);
+        jobs[i] = funcJob;
+    }
+    LinxcRunTranspileJobs(this, jobs, jobCount);
+    for (usize i = 0; i < jobCount; i++)
+    {
+        writer->Append(jobs[i].writer.buffer, jobs[i].writer.length);
+        jobs[i].writer.deinit();
+    }
+
+    defaultAllocator.Free((void**)&jobs);
+    instanceMethods.deinit();
+    uses.deinit();
+    ordered.deinit();
+    visited.deinit();
+}
+void LinxcParser::PrepareTranspile()
+{
+    if (this->preparedForTranspile)
+    {
+        return;
+    }
+    //layouts first, so that sizeof folds, and folding before the alias analysis lets it see through constants
+    LinxcComputeLayouts(this->allocator, &this->globalNamespace, this->layoutTarget);
+    if (this->reportLayouts)
+    {
+        this->layoutReport.Clear();
+        LinxcWriteLayoutReport(&this->layoutReport, &this->globalNamespace, this->layoutTarget, this->allocator);
+    }
+    LinxcFoldConstants(this->allocator, &this->globalNamespace);
+    if (this->eliminateUnreachable)
+    {
+        this->eliminated.funcs.Clear();
+        this->eliminated.types.Clear();
+        LinxcEliminateUnreachable(&this->globalNamespace, &this->eliminated);
+    }
+    //every parsed file, as a reference from any of them keeps a function or global external
+    collections::vector<LinxcParsedFile*> files = collections::vector<LinxcParsedFile*>(&defaultAllocator);
+    for (usize i = 0; i < this->parsedFiles.bucketsCount; i++)
+    {
+        if (this->parsedFiles.buckets[i].initialized)
+        {
+            for (usize j = 0; j < this->parsedFiles.buckets[i].entries.count; j++)
+            {
+                files.Add(&this->parsedFiles.buckets[i].entries.Get(j)->value);
+            }
+        }
+    }
+    LinxcInferLinkage(&this->globalNamespace, files.ptr, files.count);
+    files.deinit();
+    //only file-local functions have every call visible to the alias analysis
+    LinxcInferRestrict(&this->globalNamespace);
+    //after the alias analysis, which only ever marks pointers restrict, never the struct parameters turned into them here
+    if (this->largeStructThreshold > 0)
+    {
+        LinxcLowerLargeStructs(&this->globalNamespace, this->largeStructThreshold);
+    }
+    //the AST is read-only from here on. The only thing transpiling would otherwise allocate from this->allocator
+    //(which need not be thread-safe) are the cached C names, so compute them all up front
+    this->CacheNames(&this->globalNamespace);
+    this->preparedForTranspile = true;
+}
+void LinxcParser::CacheNames(LinxcNamespace* namespaceToCache)
+{
+    LinxcSymbolTable *symbols = &namespaceToCache->symbols;
+    for (u32 i = 0; i < symbols->capacity; i++)
+    {
+        LinxcSymbol *symbol = &symbols->slots[i];
+        switch (symbol->kind)
+        {
+        case LinxcSymbol_Func:
+            symbol->data.function->GetCName(this->allocator);
+            break;
+        case LinxcSymbol_Type:
+            this->CacheNames(symbol->data.type);
+            break;
+        case LinxcSymbol_Namespace:
+            this->CacheNames(symbol->data.namespaceRef);
+            break;
+        default:
+            break;
+        }
+    }
+}
+void LinxcParser::CacheNames(LinxcType* type)
+{
+    type->GetCName(this->allocator);
+    type->GetFullName(this->allocator);
+    for (usize i = 0; i < type->functions.count; i++)
+    {
+        type->functions.Get(i)->GetCName(this->allocator);
+    }
+    for (usize i = 0; i < type->operatorOverloads.entries.count; i++)
+    {
+        type->operatorOverloads.entries.ptr[i].func->function.GetCName(this->allocator);
+    }
+    for (usize i = 0; i < type->subTypes.count; i++)
+    {
+        this->CacheNames(type->subTypes.Get(i));
+    }
+}
+void LinxcParser::TranspileGlobalDefinitions(LinxcWriter* writer, LinxcParsedFile* file, bool includeFileLocals)
+{
+    for (usize i = 0; i < file->definedVars.count; i++)
+    {
+        LinxcVar *var = *file->definedVars.Get(i);
+        if (!var->isFileLocal || includeFileLocals)
+        {
+            this->TranspileVar(writer, var);
+            writer->Append(";\n");
+        }
+    }
+}
+void LinxcParser::TranspileStatementH(LinxcWriter* writer, LinxcStatement* stmt)
+{
+    if (stmt->ID == LinxcStmt_Include)
+    {
+        string includeName = stmt->data.includeStatement.includeString;
+        string extension = path::GetExtension(&defaultAllocator, includeName);
+        if (extension == ".linxc")
+        {
+            includeName = path::SwapExtension(&defaultAllocator, includeName, ".h");
+            //we only set the above to true here as before, we are just referencing the includeName as part of the include
+            //statement. If we deinited that, we would have modified the statement in the AST
+        }
+
+        //make sure no harpy brain programmer uses '\' to specify include paths 
+        string replaced = ReplaceChar(&defaultAllocator, includeName, '\\', '/');
+        writer->Append("#include <");
+        writer->Append(includeName.buffer);
+        writer->Append(">\n");
+        replaced.deinit();
+
+        if (includeName == "Linxc.h")
+        {
+            writer->Append("#include <stdbool.h>\n");
+        }
+
+        if (extension == ".linxc")
+        {
+            includeName.deinit();
+        }
+        extension.deinit();
+    }
+    else if (stmt->ID == LinxcStmt_Namespace)
+    {
+        //dont need to do any funny state incrementing here
+        for (usize i = 0; i < stmt->data.namespaceScope.body.count; i++)
+        {
+            TranspileStatementH(writer, stmt->data.namespaceScope.body.Get(i));
+        }
+    }
+    else if (stmt->ID == LinxcStmt_TypeDecl && stmt->data.typeDeclaration->isReachable && !stmt->data.typeDeclaration->isDependent)
+    {
+        this->TranspileType(writer, stmt->data.typeDeclaration);
+    }
+    //file-local declarations belong to the source, see TranspileFileLocals, as do the definitions of globals, see TranspileGlobalDefinitions
+    else if (stmt->ID == LinxcStmt_VarDecl && !stmt->data.varDeclaration->isFileLocal)
+    {
+        LinxcTranspileExternVar(this, writer, stmt->data.varDeclaration);
+    }
+    else if (stmt->ID == LinxcStmt_FuncDecl && stmt->data.funcDeclaration->isReachable && !stmt->data.funcDeclaration->isFileLocal)
+    {
+        this->TranspileFunc(writer, stmt->data.funcDeclaration);
+        writer->Append(";\n");
+    }
+}
+void LinxcParser::TranspileType(LinxcWriter* writer, LinxcType* type)
+{
+    //the struct is tagged with its own name so that other headers can forward declare it
+    const char *typeName = type->GetCName(this->allocator);
+    writer->Append("typedef struct ");
+    writer->Append(typeName);
+    writer->Append(" {\n");
+    for (usize i = 0; i < type->variables.count; i++)
+    {
+        //reordered types are emitted in the order their layout was computed for
+        usize member = type->fieldOrder.length > 0 ? type->fieldOrder.data[i] : i;
+        writer->Append("   ");
+        this->TranspileVar(writer, type->variables.Get(member));
+        writer->Append(";\n");
+    }
+    writer->Append("} ");
+    writer->Append(typeName);
+    writer->Append(";\n");
+    if (type->attributes & LinxcAttribute_SoA)
+    {
+        this->TranspileSoA(writer, type);
+    }
+
+    for (usize i = 0; i < type->functions.count; i++)
+    {
+        LinxcFunc *method = type->functions.Get(i);
+        if (method->isReachable)
+        {
+            this->TranspileFunc(writer, method);
+            writer->Append(";\n");
+        }
+    }
+    //operator overloads are defined right in the header, so that every use of them can be inlined
+    for (usize i = 0; i < type->operatorOverloads.entries.count; i++)
+    {
+        LinxcOperatorFunc *operatorFunc = type->operatorOverloads.entries.ptr[i].func;
+        if (operatorFunc->function.isReachable)
+        {
+            this->TranspileOperatorFunc(writer, operatorFunc);
+        }
+    }
+}
+void LinxcParser::TranspileDeclarationH(LinxcWriter* writer, LinxcStatement* stmt, LinxcInstanceUses* emitted)
+{
+    if (stmt->ID == LinxcStmt_Namespace)
+    {
+        //specializations go right before the first declaration using them, after any type they are specialized with
+        for (usize i = 0; i < stmt->data.namespaceScope.body.count; i++)
+        {
+            this->TranspileDeclarationH(writer, stmt->data.namespaceScope.body.Get(i), emitted);
+        }
+        return;
+    }
+    usize firstForward = emitted->forwards.count;
+    usize firstInstance = emitted->instances.count;
+    emitted->Collect(stmt);
+    for (usize i = firstForward; i < emitted->forwards.count; i++)
+    {
+        const char *typeName = emitted->forwards.ptr[i]->GetCName(this->allocator);
+        writer->Append("#ifndef LINXC_INSTANCE_");
+        writer->Append(typeName);
+        writer->Append("\ntypedef struct ");
+        writer->Append(typeName);
+        writer->Append(' ');
+        writer->Append(typeName);
+        writer->Append(";\n#endif\n");
+    }
+    for (usize i = firstInstance; i < emitted->instances.count; i++)
+    {
+        const char *typeName = emitted->instances.ptr[i]->GetCName(this->allocator);
+        writer->Append("#ifndef LINXC_INSTANCE_");
+        writer->Append(typeName);
+        writer->Append("\n#define LINXC_INSTANCE_");
+        writer->Append(typeName);
+        writer->Append('\n');
+        this->TranspileType(writer, emitted->instances.ptr[i]);
+        writer->Append("#endif\n");
+    }
+    this->TranspileStatementH(writer, stmt);
+}
+//Appends before, the member's name, then between and its name again if between is not NULL, and after for every member variable of type
+static void LinxcAppendPerMember(LinxcWriter* writer, LinxcType* type, const char* before, const char* between, const char* after)
+{
+    for (usize i = 0; i < type->variables.count; i++)
+    {
+        const char *name = type->variables.Get(i)->name.buffer;
+        writer->Append(before);
+        writer->Append(name);
+        if (between != NULL)
+        {
+            writer->Append(between);
+            writer->Append(name);
+        }
+        writer->Append(after);
+    }
+}
+//Appends a call to the SoA_Free of type for every member array that is not NULL, naming the arrays with before and prefix
+static void LinxcAppendSoAFrees(LinxcWriter* writer, LinxcType* type, const char* typeName, const char* before, const char* prefix)
+{
+    for (usize i = 0; i < type->variables.count; i++)
+    {
+        const char *name = type->variables.Get(i)->name.buffer;
+        writer->Append(before);
+        writer->Append(prefix);
+        writer->Append(name);
+        writer->Append(" != NULL) ");
+        writer->Append(typeName);
+        writer->Append("SoA_Free(linxcContainer, ");
+        writer->Append(prefix);
+        writer->Append(name);
+        writer->Append(");\n");
+    }
+}
+void LinxcParser::TranspileSoA(LinxcWriter* writer, LinxcType* type)
+{
+    const char *typeName = type->GetCName(this->allocator);
+    //element types of the arrays. const on a pointer member applies to what it points to, so it is kept,
+    //while other const members are stored mutably as the container writes them
+    LinxcTypeReference *memberTypes = (LinxcTypeReference*)defaultAllocator.Allocate(sizeof(LinxcTypeReference) * (type->variables.count + 1));
+    for (usize i = 0; i < type->variables.count; i++)
+    {
+        LinxcVar *member = type->variables.Get(i);
+        memberTypes[i] = member->type.AsTypeReference().value;
+        memberTypes[i].isConst = member->isConst && memberTypes[i].pointerCount > 0;
+    }
+
+    //a container initialized without an allocation function uses the C allocator, calling malloc and free directly
+    writer->Append("#include <stdlib.h>\n");
+    writer->Append("typedef struct ");
+    writer->Append(typeName);
+    writer->Append("SoA {\n   void* linxcAllocatorInstance;\n   LinxcAllocFunc linxcAllocFunction;\n   LinxcFreeFunc linxcFreeFunction;\n   usize linxcCount;\n   usize linxcCapacity;\n");
+    for (usize i = 0; i < type->variables.count; i++)
+    {
+        writer->Append("   ");
+        this->TranspileTypeReference(writer, &memberTypes[i]);
+        writer->Append("* ");
+        writer->Append(type->variables.Get(i)->name.buffer);
+        writer->Append(";\n");
+    }
+    writer->Append("} ");
+    writer->Append(typeName);
+    writer->Append("SoA;\n");
+
+    //Init
+    writer->Append("static inline ");
+    writer->Append(typeName);
+    writer->Append("SoA ");
+    writer->Append(typeName);
+    writer->Append("SoA_Init(void* linxcAllocatorInstance, LinxcAllocFunc linxcAllocFunction, LinxcFreeFunc linxcFreeFunction)\n{\n   ");
+    writer->Append(typeName);
+    writer->Append("SoA linxcResult;\n   linxcResult.linxcAllocatorInstance = linxcAllocatorInstance;\n   linxcResult.linxcAllocFunction = linxcAllocFunction;\n   linxcResult.linxcFreeFunction = linxcFreeFunction;\n   linxcResult.linxcCount = 0;\n   linxcResult.linxcCapacity = 0;\n");
+    LinxcAppendPerMember(writer, type, "   linxcResult.", NULL, " = NULL;\n");
+    writer->Append("   return linxcResult;\n}\n");
+
+    //Allocate and Free: the C allocator is checked for first so that its calls are direct, and fold away once Init is inlined
+    writer->Append("static inline void* ");
+    writer->Append(typeName);
+    writer->Append("SoA_Allocate(");
+    writer->Append(typeName);
+    writer->Append("SoA* linxcContainer, usize linxcBytes)\n{\n   if (linxcContainer->linxcAllocFunction == NULL)\n   {\n      return malloc(linxcBytes);\n   }\n   return linxcContainer->linxcAllocFunction(linxcContainer->linxcAllocatorInstance, linxcBytes);\n}\n");
+    writer->Append("static inline void ");
+    writer->Append(typeName);
+    writer->Append("SoA_Free(");
+    writer->Append(typeName);
+    writer->Append("SoA* linxcContainer, void* linxcPtr)\n{\n   if (linxcContainer->linxcFreeFunction == NULL)\n   {\n      free(linxcPtr);\n      return;\n   }\n   linxcContainer->linxcFreeFunction(linxcContainer->linxcAllocatorInstance, linxcPtr);\n}\n");
+
+    //Reserve: grows every array to at least linxcMinCapacity in one go, leaving the container untouched if any allocation fails
+    writer->Append("static inline bool ");
+    writer->Append(typeName);
+    writer->Append("SoA_Reserve(");
+    writer->Append(typeName);
+    writer->Append("SoA* linxcContainer, usize linxcMinCapacity)\n{\n   if (linxcMinCapacity <= linxcContainer->linxcCapacity)\n   {\n      return true;\n   }\n");
+    writer->Append("   usize linxcNewCapacity = linxcContainer->linxcCapacity == 0 ? 8 : linxcContainer->linxcCapacity * 2;\n   while (linxcNewCapacity < linxcMinCapacity)\n   {\n      linxcNewCapacity *= 2;\n   }\n");
+    for (usize i = 0; i < type->variables.count; i++)
+    {
+        writer->Append("   ");
+        this->TranspileTypeReference(writer, &memberTypes[i]);
+        writer->Append("* ");
+        writer->Append(type->variables.Get(i)->name.buffer);
+        writer->Append(" = (");
+        this->TranspileTypeReference(writer, &memberTypes[i]);
+        writer->Append("*)");
+        writer->Append(typeName);
+        writer->Append("SoA_Allocate(linxcContainer, sizeof(");
+        this->TranspileTypeReference(writer, &memberTypes[i]);
+        writer->Append(") * linxcNewCapacity);\n");
+    }
+    if (type->variables.count > 0)
+    {
+        writer->Append("   if (");
+        for (usize i = 0; i < type->variables.count; i++)
+        {
+            if (i > 0)
+            {
+                writer->Append(" || ");
+            }
+            writer->Append(type->variables.Get(i)->name.buffer);
+            writer->Append(" == NULL");
+        }
+        writer->Append(")\n   {\n");
+        LinxcAppendSoAFrees(writer, type, typeName, "      if (", "");
+        writer->Append("      return false;\n   }\n");
+    }
+    writer->Append("   for (usize linxcI = 0; linxcI < linxcContainer->linxcCount; linxcI++)\n   {\n");
+    LinxcAppendPerMember(writer, type, "      ", "[linxcI] = linxcContainer->", "[linxcI];\n");
+    writer->Append("   }\n");
+    LinxcAppendSoAFrees(writer, type, typeName, "   if (", "linxcContainer->");
+    LinxcAppendPerMember(writer, type, "   linxcContainer->", " = ", ";\n");
+    writer->Append("   linxcContainer->linxcCapacity = linxcNewCapacity;\n   return true;\n}\n");
+
+    //Add
+    writer->Append("static inline bool ");
+    writer->Append(typeName);
+    writer->Append("SoA_Add(");
+    writer->Append(typeName);
+    writer->Append("SoA* linxcContainer, ");
+    writer->Append(typeName);
+    writer->Append(" linxcValue)\n{\n   if (!");
+    writer->Append(typeName);
+    writer->Append("SoA_Reserve(linxcContainer, linxcContainer->linxcCount + 1))\n   {\n      return false;\n   }\n");
+    LinxcAppendPerMember(writer, type, "   linxcContainer->", "[linxcContainer->linxcCount] = linxcValue.", ";\n");
+    writer->Append("   linxcContainer->linxcCount += 1;\n   return true;\n}\n");
+
+    //Get
+    writer->Append("static inline ");
+    writer->Append(typeName);
+    writer->Append(' ');
+    writer->Append(typeName);
+    writer->Append("SoA_Get(const ");
+    writer->Append(typeName);
+    writer->Append("SoA* linxcContainer, usize linxcIndex)\n{\n   ");
+    writer->Append(typeName);
+    writer->Append(" linxcResult;\n");
+    LinxcAppendPerMember(writer, type, "   linxcResult.", " = linxcContainer->", "[linxcIndex];\n");
+    writer->Append("   return linxcResult;\n}\n");
+
+    //Set
+    writer->Append("static inline void ");
+    writer->Append(typeName);
+    writer->Append("SoA_Set(");
+    writer->Append(typeName);
+    writer->Append("SoA* linxcContainer, usize linxcIndex, ");
+    writer->Append(typeName);
+    writer->Append(" linxcValue)\n{\n");
+    LinxcAppendPerMember(writer, type, "   linxcContainer->", "[linxcIndex] = linxcValue.", ";\n");
+    writer->Append("}\n");
+
+    //Deinit
+    writer->Append("static inline void ");
+    writer->Append(typeName);
+    writer->Append("SoA_Deinit(");
+    writer->Append(typeName);
+    writer->Append("SoA* linxcContainer)\n{\n");
+    LinxcAppendSoAFrees(writer, type, typeName, "   if (", "linxcContainer->");
+    LinxcAppendPerMember(writer, type, "   linxcContainer->", NULL, " = NULL;\n");
+    writer->Append("   linxcContainer->linxcCount = 0;\n   linxcContainer->linxcCapacity = 0;\n}\n");
+
+    defaultAllocator.Free((void**)&memberTypes);
+}
+void LinxcParser::TranspileFunc(LinxcWriter* writer, LinxcFunc* func)
+{
+    LinxcTypeReference typeRef = func->returnType.AsTypeReference().value;
+    if (func->returnsThroughPointer)
+    {
+        writer->Append("void");
+    }
+    else this->TranspileTypeReference(writer, &typeRef);
+    writer->Append(" ");
+
+    writer->Append(func->GetCName(this->allocator));
+    writer->Append('(');
+
+    if (func->returnsThroughPointer)
+    {
+        writer->Append(typeRef.lastType->GetCName(this->allocator));
+        writer->Append(" *linxcResult");
+        if (func->methodOf != NULL || func->arguments.length > 0)
+        {
+            writer->Append(", ");
+        }
+    }
+
+    //if we are a member function of a struct, the first argument will always be 'this'
+    if (func->methodOf != NULL)
+    {
+        writer->Append(func->methodOf->GetCName(this->allocator));
+        writer->Append(" *this");
+        if (func->arguments.length > 0)
+        {
+            writer->Append(", ");
+        }
+    }
+    for (usize i = 0; i < func->arguments.length; i++)
+    {
+        this->TranspileVar(writer, &func->arguments.data[i]);
+        if (i < func->arguments.length - 1)
+        {
+            writer->Append(", ");
+        }
+    }
+
+    writer->Append(")");
+}
+void LinxcParser::TranspileOperatorFunc(LinxcWriter* writer, LinxcOperatorFunc* operatorFunc)
+{
+    LinxcFunc *func = &operatorFunc->function;
+    const char *typeName = func->methodOf->GetCName(this->allocator);
+    LinxcTypeReference typeRef = func->returnType.AsTypeReference().value;
+    writer->Append("static inline ");
+    this->TranspileTypeReference(writer, &typeRef);
+    writer->Append(" ");
+    writer->Append(func->GetCName(this->allocator));
+    writer->Append('(');
+    writer->Append(typeName);
+    writer->Append(" thisValue, ");
+    this->TranspileVar(writer, &func->arguments.data[0]);
+    writer->Append(")\n{\n");
+    //the left operand may not be addressable, so it is passed by value and the body gets a pointer to the copy
+    writer->Append(typeName);
+    writer->Append(" *this = &thisValue;\n");
+    for (usize i = 0; i < func->body.count; i++)
+    {
+        this->TranspileStatementC(writer, func, func->body.Get(i));
+        writer->Append(";\n");
+    }
+    writer->Append("}\n");
+}
+void LinxcParser::TranspileFunctionCall(LinxcWriter* writer, LinxcFunctionCall* call, LinxcExpression* thisExpr, bool thisIsPointer, const char* resultPointer)
+{
+    writer->Append(call->func->GetCName(this->allocator));
+    writer->Append('(');
+    if (resultPointer != NULL)
+    {
+        writer->Append(resultPointer);
+        if (call->inputParams.length > 0)
+        {
+            writer->Append(", ");
+        }
+    }
+    if (call->func->methodOf != NULL)
+    {
+        if (thisExpr == NULL)
+        {
+            writer->Append("this");
+        }
+        else
+        {
+            if (!thisIsPointer)
+            {
+                writer->Append('&');
+            }
+            this->TranspileExpr(writer, thisExpr);
+        }
+        if (call->inputParams.length > 0)
+        {
+            writer->Append(", ");
+        }
+    }
+    for (usize i = 0; i < call->inputParams.length; i++)
+    {
+        LinxcExpression *input = &call->inputParams.data[i];
+        if (i < call->func->arguments.length && call->func->arguments.data[i].isPassedByPointer)
+        {
+            //a parameter passed by pointer itself is passed on as is
+            if (input->ID == LinxcExpr_Variable && input->data.variable->isPassedByPointer)
+            {
+                writer->Append(input->data.variable->name.buffer);
+            }
+            else
+            {
+                writer->Append('&');
+                this->TranspileExpr(writer, input);
+            }
+        }
+        else this->TranspileExpr(writer, input);
+        if (i < call->inputParams.length - 1)
+        {
+            writer->Append(", ");
+        }
+    }
+    writer->Append(')');
+}
+void LinxcParser::TranspileExpr(LinxcWriter* writer, LinxcExpression* expr)
+{
+    switch (expr->ID)
+    {
+    case LinxcExpr_None:
+        break;
+    case LinxcExpr_Literal:
+    {
+        writer->Append(expr->data.literal.buffer);
+    }
+    break;
+    case LinxcExpr_Variable:
+    {
+        if (expr->data.variable->isPassedByPointer)
+        {
+            writer->Append("(*");
+            writer->Append(expr->data.variable->name.buffer);
+            writer->Append(')');
+        }
+        else writer->Append(expr->data.variable->name.buffer);
+    }
+    break;
+    case LinxcExpr_Modified:
+    {
+        writer->Append(LinxcTokenIDToString(expr->data.modifiedExpression->modification));
+        this->TranspileExpr(writer, &expr->data.modifiedExpression->expression);
+    }
+    break;
+    case LinxcExpr_FuncCall:
+    {
+        //a method called without an object is called on our own this
+        this->TranspileFunctionCall(writer, &expr->data.functionCall, NULL, true, NULL);
+    }
+    break;
+    case LinxcExpr_FunctionRef:
+    {
+        writer->Append(expr->data.functionRef->GetCName(this->allocator));
+        writer->Append('(');
+    }
+    break;
+    case LinxcExpr_TypeCast:
+    {
+        LinxcTypeReference castTo = expr->data.typeCast->castToType.AsTypeReference().value;
+        writer->Append("((");
+        this->TranspileTypeReference(writer, &castTo);
+        writer->Append(')');
+        this->TranspileExpr(writer, &expr->data.typeCast->expressionToCast);
+        writer->Append(')');
+    }
+    break;
+    case LinxcExpr_Sizeof:
+    {
+        writer->Append("sizeof(");
+        this->TranspileTypeReference(writer, &expr->data.sizeofCall);
+        writer->Append(')');
+    }
+    break;
+    case LinxcExpr_OperatorCall:
+    {
+        //when transpiling an operator with a scope resolution operation, we should ignore the
+        //resolution and only transpile the right side until we reach the variable/function/type.
+        //this is so as to prevent duplicate namespace scopes when transpiled to C, as we need
+        //to transpile the variable/function/type as it's complete C friendly name.
+        //If we were to transpile it as is, and make the C friendly name by transpiling scope resolution operators,
+        //variables/functions/types contained in a using'd namespace would be improperly transpiled
+        LinxcOperator *operatorCall = expr->data.operatorCall;
+        if (operatorCall->operatorType == Linxc_ColonColon)
+        {
+            this->TranspileExpr(writer, &operatorCall->rightExpr);
+        }
+        else if ((operatorCall->operatorType == Linxc_Period || operatorCall->operatorType == Linxc_Arrow) && operatorCall->rightExpr.ID == LinxcExpr_FuncCall)
+        {
+            //methods take the object they are called on as their first argument
+            this->TranspileFunctionCall(writer, &operatorCall->rightExpr.data.functionCall, &operatorCall->leftExpr, operatorCall->operatorType == Linxc_Arrow, NULL);
+        }
+        else if (operatorCall->overload != NULL)
+        {
+            //the overload may be defined on the type of either side, and takes the side of its own type first
+            LinxcExpression *first = &operatorCall->leftExpr;
+            LinxcExpression *second = &operatorCall->rightExpr;
+            LinxcTypeReference myType = operatorCall->overload->operatorOverride.myType;
+            if (!(first->resolvesTo.lastType == myType.lastType && first->resolvesTo.pointerCount == myType.pointerCount))
+            {
+                first = &operatorCall->rightExpr;
+                second = &operatorCall->leftExpr;
+            }
+            writer->Append(operatorCall->overload->function.GetCName(this->allocator));
+            writer->Append('(');
+            this->TranspileExpr(writer, first);
+            writer->Append(", ");
+            this->TranspileExpr(writer, second);
+            writer->Append(')');
+        }
+        else
+        {
+            LinxcTokenID opType = expr->data.operatorCall->operatorType;
+            bool writePriority = opType != Linxc_ColonColon && opType != Linxc_Arrow && opType != Linxc_Period && opType != Linxc_Equal;
+            if (writePriority)
+            {
+                writer->Append("(");
+            }
+            this->TranspileExpr(writer, &expr->data.operatorCall->leftExpr);
+            //if not ::, ->, ., yes space
+            if (opType != Linxc_ColonColon && opType != Linxc_Arrow && opType != Linxc_Period)
+            {
+                writer->Append(' ');
+                writer->Append(LinxcTokenIDToString(expr->data.operatorCall->operatorType));
+                writer->Append(' ');
+            }
+            //no space
+            else writer->Append(LinxcTokenIDToString(expr->data.operatorCall->operatorType));
+            this->TranspileExpr(writer, &expr->data.operatorCall->rightExpr);
+            if (writePriority)
+            {
+                writer->Append(")");
+            }
+        }
+    }
+    break;
+    default:
+        break;
+    }
+}
+void LinxcParser::TranspileTypeReference(LinxcWriter* writer, LinxcTypeReference* typeRef)
+{
+    if (typeRef->isConst)
+    {
+        writer->Append("const ");
+    }
+    writer->Append(typeRef->lastType->GetCName(this->allocator));
+    for (u32 i = 0; i < typeRef->pointerCount; i++)
+    {
+        writer->Append("*");
+    }
+}
+void LinxcParser::TranspileVar(LinxcWriter* writer, LinxcVar* var)
+{
+    LinxcTypeReference typeRef = var->type.AsTypeReference().value;
+    if (var->isPassedByPointer)
+    {
+        //the callee only ever reads through it, so it points to the caller's argument
+        typeRef.isConst = true;
+        typeRef.pointerCount += 1;
+    }
+    else if (var->isConst)
+    {
+        writer->Append("const ");
+    }
+    this->TranspileTypeReference(writer, &typeRef);
+    writer->Append(" ");
+    if (var->isRestrict)
+    {
+        writer->Append("restrict ");
+    }
+    writer->Append(var->name.buffer);
+    if (var->defaultValue.present)
+    {
+        writer->Append(" = "); //temp
+        this->TranspileExpr(writer, &var->defaultValue.value);
+    }
+    //else writer->Append(";\n");
+}
+void LinxcParser::TranspileStatementC(LinxcWriter* writer, LinxcFunc* func, LinxcStatement* stmt)
+{
+    //LinxcLowerLargeStructs only lets a call to a function returning through a pointer be one of the statements below,
+    //so the pointer is always to the variable it initializes, whatever it is assigned to, or a temporary
+    if (stmt->ID == LinxcStmt_Expr)
+    {
+        LinxcExpression *expr = &stmt->data.expression;
+        LinxcFunctionCall *lowered = LinxcCallReturningThroughPointer(expr);
+        if (lowered != NULL)
+        {
+            LinxcTypeReference typeRef = lowered->func->returnType.AsTypeReference().value;
+            writer->Append("{ ");
+            writer->Append(typeRef.lastType->GetCName(this->allocator));
+            writer->Append(" linxcReturned; ");
+            this->TranspileFunctionCall(writer, lowered, NULL, true, "&linxcReturned");
+            writer->Append("; }");
+        }
+        else if (expr->ID == LinxcExpr_OperatorCall && expr->data.operatorCall->operatorType == Linxc_Equal
+            && (lowered = LinxcCallReturningThroughPointer(&expr->data.operatorCall->rightExpr)) != NULL)
+        {
+            LinxcWriter resultPointer = LinxcWriter(&defaultAllocator);
+            resultPointer.Append('&');
+            this->TranspileExpr(&resultPointer, &expr->data.operatorCall->leftExpr);
+            resultPointer.Append('\0');
+            this->TranspileFunctionCall(writer, lowered, NULL, true, resultPointer.buffer);
+            resultPointer.deinit();
+        }
+        else this->TranspileExpr(writer, expr);
+    }
+    else if (stmt->ID == LinxcStmt_Return)
+    {
+        LinxcFunctionCall *lowered = LinxcCallReturningThroughPointer(&stmt->data.returnStatement);
+        if (lowered != NULL && func->returnsThroughPointer)
+        {
+            this->TranspileFunctionCall(writer, lowered, NULL, true, "linxcResult");
+            writer->Append("; return");
+        }
+        else if (lowered != NULL)
+        {
+            LinxcTypeReference typeRef = lowered->func->returnType.AsTypeReference().value;
+            writer->Append("{ ");
+            writer->Append(typeRef.lastType->GetCName(this->allocator));
+            writer->Append(" linxcReturned; ");
+            this->TranspileFunctionCall(writer, lowered, NULL, true, "&linxcReturned");
+            writer->Append("; return linxcReturned; }");
+        }
+        else if (func->returnsThroughPointer)
+        {
+            writer->Append("*linxcResult = ");
+            this->TranspileExpr(writer, &stmt->data.returnStatement);
+            writer->Append("; return");
+        }
+        else
+        {
+            writer->Append("return ");
+            this->TranspileExpr(writer, &stmt->data.returnStatement);
+        }
+    }
+    else if (stmt->ID == LinxcStmt_VarDecl)
+    {
+        LinxcVar *var = stmt->data.varDeclaration;
+        LinxcFunctionCall *lowered = var->defaultValue.present ? LinxcCallReturningThroughPointer(&var->defaultValue.value) : NULL;
+        if (lowered != NULL)
+        {
+            //declared without its initializer, which then writes to it
+            LinxcVar declared = *var;
+            declared.defaultValue = option<LinxcExpression>();
+            this->TranspileVar(writer, &declared);
+            writer->Append("; ");
+            LinxcWriter resultPointer = LinxcWriter(&defaultAllocator);
+            resultPointer.Append('&');
+            resultPointer.Append(var->name.buffer);
+            resultPointer.Append('\0');
+            this->TranspileFunctionCall(writer, lowered, NULL, true, resultPointer.buffer);
+            resultPointer.deinit();
+        }
+        else this->TranspileVar(writer, var);
     }
 }
\ No newline at end of file
@@ -0,0 +1,311 @@
+#include <reachability.hpp>
+
+LinxcEliminationReport::LinxcEliminationReport()
+{
+    this->funcs = collections::vector<LinxcFunc*>();
+    this->types = collections::vector<LinxcType*>();
+}
+LinxcEliminationReport::LinxcEliminationReport(IAllocator *allocator)
+{
+    this->funcs = collections::vector<LinxcFunc*>(allocator);
+    this->types = collections::vector<LinxcType*>(allocator);
+}
+//Appends every named namespace enclosing (and including) nameSpace, outermost first, each followed by ::
+static void LinxcAppendNamespacePath(LinxcWriter *writer, LinxcNamespace *nameSpace)
+{
+    if (nameSpace == NULL)
+    {
+        return;
+    }
+    LinxcAppendNamespacePath(writer, nameSpace->parentNamespace);
+    if (nameSpace->name.buffer != NULL)
+    {
+        writer->Append(nameSpace->name.buffer);
+        writer->Append("::");
+    }
+}
+void LinxcEliminationReport::Write(LinxcWriter *writer, IAllocator *nameAllocator)
+{
+    for (usize i = 0; i < this->types.count; i++)
+    {
+        writer->Append("type ");
+        writer->Append(this->types.ptr[i]->GetFullName(nameAllocator));
+        writer->Append('\n');
+    }
+    for (usize i = 0; i < this->funcs.count; i++)
+    {
+        LinxcFunc *func = this->funcs.ptr[i];
+        writer->Append("function ");
+        if (func->methodOf != NULL)
+        {
+            writer->Append(func->methodOf->GetFullName(nameAllocator));
+            writer->Append("::");
+        }
+        else LinxcAppendNamespacePath(writer, func->funcNamespace);
+        writer->Append(func->name.buffer);
+        writer->Append('\n');
+    }
+}
+void LinxcEliminationReport::deinit()
+{
+    this->funcs.deinit();
+    this->types.deinit();
+}
+
+/// Functions and types found reachable but not yet walked.
+struct LinxcReachabilityState
+{
+    collections::vector<LinxcFunc*> funcs;
+    collections::vector<LinxcType*> types;
+};
+
+static void LinxcMarkFunc(LinxcReachabilityState *state, LinxcFunc *func)
+{
+    if (func != NULL && !func->isReachable)
+    {
+        func->isReachable = true;
+        state->funcs.Add(func);
+    }
+}
+static void LinxcMarkType(LinxcReachabilityState *state, LinxcType *type)
+{
+    //primitives are never transpiled, so there is nothing to eliminate
+    if (type != NULL && type->primitiveID == LinxcPrimitive_None && !type->isReachable)
+    {
+        type->isReachable = true;
+        state->types.Add(type);
+    }
+}
+
+static void LinxcReachExpr(LinxcReachabilityState *state, LinxcExpression *expr);
+static void LinxcReachVar(LinxcReachabilityState *state, LinxcVar *var)
+{
+    LinxcReachExpr(state, &var->type);
+    if (var->defaultValue.present)
+    {
+        LinxcReachExpr(state, &var->defaultValue.value);
+    }
+}
+static void LinxcReachExpr(LinxcReachabilityState *state, LinxcExpression *expr)
+{
+    LinxcMarkType(state, expr->resolvesTo.lastType);
+    switch (expr->ID)
+    {
+    case LinxcExpr_FunctionRef:
+        LinxcMarkFunc(state, expr->data.functionRef);
+        break;
+    case LinxcExpr_TypeRef:
+        LinxcMarkType(state, expr->data.typeRef.lastType);
+        break;
+    case LinxcExpr_Sizeof:
+        LinxcMarkType(state, expr->data.sizeofCall.lastType);
+        break;
+    case LinxcExpr_Modified:
+        LinxcReachExpr(state, &expr->data.modifiedExpression->expression);
+        break;
+    case LinxcExpr_TypeCast:
+        LinxcReachExpr(state, &expr->data.typeCast->castToType);
+        LinxcReachExpr(state, &expr->data.typeCast->expressionToCast);
+        break;
+    case LinxcExpr_FuncCall:
+    {
+        LinxcFunctionCall *call = &expr->data.functionCall;
+        LinxcMarkFunc(state, call->func);
+        for (usize i = 0; i < call->inputParams.length; i++)
+        {
+            LinxcReachExpr(state, &call->inputParams.data[i]);
+        }
+        for (usize i = 0; i < call->templateSpecializations.length; i++)
+        {
+            LinxcMarkType(state, call->templateSpecializations.data[i].lastType);
+        }
+    }
+    break;
+    case LinxcExpr_OperatorCall:
+        if (expr->data.operatorCall->overload != NULL)
+        {
+            LinxcMarkFunc(state, &expr->data.operatorCall->overload->function);
+        }
+        LinxcReachExpr(state, &expr->data.operatorCall->leftExpr);
+        LinxcReachExpr(state, &expr->data.operatorCall->rightExpr);
+        break;
+    default:
+        break;
+    }
+}
+static void LinxcReachBody(LinxcReachabilityState *state, collections::vector<LinxcStatement> *body)
+{
+    for (usize i = 0; i < body->count; i++)
+    {
+        LinxcStatement *stmt = body->Get(i);
+        if (stmt->ID == LinxcStmt_Expr)
+        {
+            LinxcReachExpr(state, &stmt->data.expression);
+        }
+        else if (stmt->ID == LinxcStmt_Return)
+        {
+            LinxcReachExpr(state, &stmt->data.returnStatement);
+        }
+        else if (stmt->ID == LinxcStmt_VarDecl)
+        {
+            LinxcReachVar(state, stmt->data.varDeclaration);
+        }
+    }
+}
+static void LinxcReachFunc(LinxcReachabilityState *state, LinxcFunc *func)
+{
+    //a method's declaration names its type through this
+    LinxcMarkType(state, func->methodOf);
+    LinxcReachExpr(state, &func->returnType);
+    for (usize i = 0; i < func->arguments.length; i++)
+    {
+        LinxcReachVar(state, &func->arguments.data[i]);
+    }
+    LinxcReachBody(state, &func->body);
+}
+static void LinxcReachType(LinxcReachabilityState *state, LinxcType *type)
+{
+    for (usize i = 0; i < type->variables.count; i++)
+    {
+        LinxcReachVar(state, type->variables.Get(i));
+    }
+}
+
+/// Every function and type declared in the program, each starting out unreachable.
+struct LinxcReachabilityDecls
+{
+    collections::vector<LinxcFunc*> funcs;
+    collections::vector<LinxcType*> types;
+    collections::vector<LinxcVar*> globals;
+};
+static void LinxcCollectDeclsType(LinxcReachabilityDecls *decls, LinxcType *type)
+{
+    //templates are never emitted themselves, only their specializations, which are types of their own
+    if (type->isDependent)
+    {
+        return;
+    }
+    type->isReachable = false;
+    decls->types.Add(type);
+    for (usize i = 0; i < type->functions.count; i++)
+    {
+        LinxcFunc *func = type->functions.Get(i);
+        func->isReachable = false;
+        decls->funcs.Add(func);
+    }
+    for (usize i = 0; i < type->operatorOverloads.entries.count; i++)
+    {
+        LinxcFunc *func = &type->operatorOverloads.entries.ptr[i].func->function;
+        func->isReachable = false;
+        decls->funcs.Add(func);
+    }
+    for (usize i = 0; i < type->subTypes.count; i++)
+    {
+        LinxcCollectDeclsType(decls, type->subTypes.Get(i));
+    }
+}
+static void LinxcCollectDecls(LinxcReachabilityDecls *decls, LinxcNamespace *nameSpace)
+{
+    LinxcSymbolTable *symbols = &nameSpace->symbols;
+    for (u32 i = 0; i < symbols->capacity; i++)
+    {
+        LinxcSymbol *symbol = &symbols->slots[i];
+        switch (symbol->kind)
+        {
+        case LinxcSymbol_Func:
+            symbol->data.function->isReachable = false;
+            decls->funcs.Add(symbol->data.function);
+            break;
+        case LinxcSymbol_Var:
+            decls->globals.Add(symbol->data.variable);
+            break;
+        case LinxcSymbol_Type:
+            LinxcCollectDeclsType(decls, symbol->data.type);
+            break;
+        case LinxcSymbol_Namespace:
+            LinxcCollectDecls(decls, symbol->data.namespaceRef);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+void LinxcEliminateUnreachable(LinxcNamespace *rootNamespace, LinxcEliminationReport *report)
+{
+    LinxcReachabilityDecls decls;
+    decls.funcs = collections::vector<LinxcFunc*>(&defaultAllocator);
+    decls.types = collections::vector<LinxcType*>(&defaultAllocator);
+    decls.globals = collections::vector<LinxcVar*>(&defaultAllocator);
+    LinxcCollectDecls(&decls, rootNamespace);
+
+    LinxcReachabilityState state;
+    state.funcs = collections::vector<LinxcFunc*>(&defaultAllocator);
+    state.types = collections::vector<LinxcType*>(&defaultAllocator);
+
+    LinxcFunc *mainFunc = NULL;
+    LinxcSymbolTable *symbols = &rootNamespace->symbols;
+    for (u32 i = 0; i < symbols->capacity; i++)
+    {
+        if (symbols->slots[i].kind == LinxcSymbol_Func && symbols->slots[i].data.function->name == "Main")
+        {
+            mainFunc = symbols->slots[i].data.function;
+        }
+    }
+    for (usize i = 0; i < decls.funcs.count; i++)
+    {
+        if (mainFunc == NULL || (decls.funcs.ptr[i]->attributes & LinxcAttribute_Keep))
+        {
+            LinxcMarkFunc(&state, decls.funcs.ptr[i]);
+        }
+    }
+    LinxcMarkFunc(&state, mainFunc);
+    for (usize i = 0; i < decls.types.count; i++)
+    {
+        if (decls.types.ptr[i]->attributes & LinxcAttribute_Keep)
+        {
+            LinxcMarkType(&state, decls.types.ptr[i]);
+        }
+    }
+    for (usize i = 0; i < decls.globals.count; i++)
+    {
+        LinxcReachVar(&state, decls.globals.ptr[i]);
+    }
+
+    while (state.funcs.count > 0 || state.types.count > 0)
+    {
+        if (state.funcs.count > 0)
+        {
+            LinxcFunc *func = state.funcs.ptr[state.funcs.count - 1];
+            state.funcs.RemoveAt_Swap(state.funcs.count - 1);
+            LinxcReachFunc(&state, func);
+        }
+        else
+        {
+            LinxcType *type = state.types.ptr[state.types.count - 1];
+            state.types.RemoveAt_Swap(state.types.count - 1);
+            LinxcReachType(&state, type);
+        }
+    }
+
+    for (usize i = 0; i < decls.types.count; i++)
+    {
+        if (!decls.types.ptr[i]->isReachable)
+        {
+            report->types.Add(decls.types.ptr[i]);
+        }
+    }
+    for (usize i = 0; i < decls.funcs.count; i++)
+    {
+        if (!decls.funcs.ptr[i]->isReachable)
+        {
+            report->funcs.Add(decls.funcs.ptr[i]);
+        }
+    }
+
+    state.types.deinit();
+    state.funcs.deinit();
+    decls.globals.deinit();
+    decls.types.deinit();
+    decls.funcs.deinit();
+}
@@ -235,28 +235,6 @@ bool string::operator!=(const char* other)
     return !(*this==other);
 }
 
-bool stringEql(string A, string B)
-{
-    if (A.buffer == NULL && B.buffer == NULL)
-    {
-        return true;
-    }
-    return A.eql(B.buffer);
-}
-u32 stringHash(string A)
-{
-    if (A.buffer == NULL)
-    {
-        return 7;
-    }
-    u32 hash = 7;
-    for (usize i = 0; i < A.length - 1; i++)
-    {
-        hash = hash * 31 + A.buffer[i];
-    }
-
-    return hash;
-}
 u32 charHash(const char *A)
 {
     u32 hash = 7;
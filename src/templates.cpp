@@ -0,0 +1,551 @@
+#include <templates.hpp>
+
+LinxcTemplateInstances::LinxcTemplateInstances()
+{
+    this->allocator = NULL;
+    this->byID = collections::hashmap<u32, LinxcType*, collections::IntegerKeys>();
+    this->concrete = collections::vector<LinxcType*>();
+    this->pending = collections::vector<LinxcType*>();
+    this->cloningBodies = false;
+}
+LinxcTemplateInstances::LinxcTemplateInstances(IAllocator *allocator)
+{
+    this->allocator = allocator;
+    //without an allocator, so that constructing a parser allocates nothing until the first template is instantiated
+    this->byID = collections::hashmap<u32, LinxcType*, collections::IntegerKeys>();
+    this->concrete = collections::vector<LinxcType*>(allocator);
+    this->pending = collections::vector<LinxcType*>(allocator);
+    this->cloningBodies = false;
+}
+void LinxcTemplateInstances::deinit()
+{
+    this->byID.deinit();
+    this->concrete.deinit();
+    this->pending.deinit();
+}
+
+/// Substitutes the arguments of instance for the parameters of the template it specializes.
+struct LinxcInstantiation
+{
+    LinxcTemplateInstances *instances;
+    LinxcTypeTable *typeTable;
+    LinxcOperatorIndex *operatorIndex;
+    LinxcType *templateType;
+    LinxcType *instance;
+    /// Parameters and locals of the methods cloned so far, mapped to their clones.
+    collections::hashmap<LinxcVar*, LinxcVar*, collections::PointerKeys> vars;
+    /// The method being cloned, and the clone of its this, created on first use.
+    LinxcFunc *method;
+    LinxcVar *thisVar;
+};
+
+static LinxcTypeReference LinxcSubstituteType(LinxcInstantiation *state, LinxcTypeReference typeRef)
+{
+    LinxcType *type = typeRef.lastType;
+    if (type == NULL || !type->isDependent)
+    {
+        return typeRef;
+    }
+    LinxcTypeReference result;
+    LinxcTemplateInstances *instances = state->instances;
+    if (type->templateParamIndex >= 0 && type >= state->templateType->templateParams.data && type < state->templateType->templateParams.data + state->templateType->templateParams.length)
+    {
+        result = state->instance->instanceArgs.data[type->templateParamIndex];
+    }
+    else if (type == state->templateType)
+    {
+        result = LinxcTypeReference(state->instance);
+    }
+    else if (type->templateOf != NULL)
+    {
+        //a specialization written within the template, such as Node<T>
+        LinxcTypeReference *args = (LinxcTypeReference*)defaultAllocator.Allocate(sizeof(LinxcTypeReference) * type->instanceArgs.length);
+        for (usize i = 0; i < type->instanceArgs.length; i++)
+        {
+            args[i] = LinxcSubstituteType(state, type->instanceArgs.data[i]);
+        }
+        collections::Array<LinxcTypeReference> argsArray = collections::Array<LinxcTypeReference>(&defaultAllocator, args, type->instanceArgs.length);
+        result = LinxcTypeReference(instances->Instantiate(state->typeTable, state->operatorIndex, type->templateOf, argsArray));
+        argsArray.deinit();
+    }
+    else return typeRef;
+
+    result.pointerCount += typeRef.pointerCount;
+    result.isConst = typeRef.isConst;
+    return result;
+}
+static LinxcFunc *LinxcSubstituteFunc(LinxcInstantiation *state, LinxcFunc *func)
+{
+    LinxcType *owner = func->methodOf;
+    if (owner == NULL || !owner->isDependent)
+    {
+        return func;
+    }
+    LinxcType *newOwner = LinxcSubstituteType(state, LinxcTypeReference(owner)).lastType;
+    return newOwner->functions.Get(func - owner->functions.ptr);
+}
+static LinxcVar *LinxcSubstituteVar(LinxcInstantiation *state, LinxcVar *var)
+{
+    LinxcVar **local = state->vars.Get(var);
+    if (local != NULL)
+    {
+        return *local;
+    }
+    LinxcType *templateType = state->templateType;
+    if (var >= templateType->variables.ptr && var < templateType->variables.ptr + templateType->variables.count)
+    {
+        return state->instance->variables.Get(var - templateType->variables.ptr);
+    }
+    option<LinxcTypeReference> typeRef = var->type.AsTypeReference();
+    if (state->method != NULL && var->name == "this" && typeRef.present && typeRef.value.lastType == templateType && typeRef.value.pointerCount == 1)
+    {
+        if (state->thisVar == NULL)
+        {
+            state->thisVar = (LinxcVar*)state->instances->allocator->Allocate(sizeof(LinxcVar));
+            *state->thisVar = LinxcVar(var->name, state->instance->AsExpression(), option<LinxcExpression>());
+            state->thisVar->type.data.typeRef.pointerCount += 1;
+        }
+        return state->thisVar;
+    }
+    return var;
+}
+
+static LinxcExpression LinxcCloneExpr(LinxcInstantiation *state, LinxcExpression *expr)
+{
+    IAllocator *allocator = state->instances->allocator;
+    LinxcExpression result = *expr;
+    result.resolvesTo = LinxcSubstituteType(state, expr->resolvesTo);
+    switch (expr->ID)
+    {
+    case LinxcExpr_IncrementVar:
+        result.data.incrementVariable = LinxcSubstituteVar(state, expr->data.incrementVariable);
+        break;
+    case LinxcExpr_DecrementVar:
+        result.data.decrementVariable = LinxcSubstituteVar(state, expr->data.decrementVariable);
+        break;
+    case LinxcExpr_Variable:
+        result.data.variable = LinxcSubstituteVar(state, expr->data.variable);
+        break;
+    case LinxcExpr_FunctionRef:
+        result.data.functionRef = LinxcSubstituteFunc(state, expr->data.functionRef);
+        break;
+    case LinxcExpr_TypeRef:
+        result.data.typeRef = LinxcSubstituteType(state, expr->data.typeRef);
+        break;
+    case LinxcExpr_Sizeof:
+        result.data.sizeofCall = LinxcSubstituteType(state, expr->data.sizeofCall);
+        break;
+    case LinxcExpr_Nameof:
+        result.data.nameofCall = LinxcSubstituteType(state, expr->data.nameofCall);
+        break;
+    case LinxcExpr_Typeof:
+        result.data.typeofCall = LinxcSubstituteType(state, expr->data.typeofCall);
+        break;
+    case LinxcExpr_Modified:
+    {
+        LinxcModifiedExpression *modified = (LinxcModifiedExpression*)allocator->Allocate(sizeof(LinxcModifiedExpression));
+        modified->modification = expr->data.modifiedExpression->modification;
+        modified->expression = LinxcCloneExpr(state, &expr->data.modifiedExpression->expression);
+        result.data.modifiedExpression = modified;
+    }
+    break;
+    case LinxcExpr_TypeCast:
+    {
+        LinxcTypeCast *typeCast = (LinxcTypeCast*)allocator->Allocate(sizeof(LinxcTypeCast));
+        typeCast->castToType = LinxcCloneExpr(state, &expr->data.typeCast->castToType);
+        typeCast->expressionToCast = LinxcCloneExpr(state, &expr->data.typeCast->expressionToCast);
+        result.data.typeCast = typeCast;
+    }
+    break;
+    case LinxcExpr_Indexer:
+        result.data.indexerCall = LinxcCloneExpr(state, expr->data.indexerCall).ToHeap(allocator);
+        break;
+    case LinxcExpr_FuncCall:
+    {
+        LinxcFunctionCall *call = &expr->data.functionCall;
+        result.data.functionCall.func = LinxcSubstituteFunc(state, call->func);
+        LinxcExpression *inputParams = (LinxcExpression*)allocator->Allocate(sizeof(LinxcExpression) * (call->inputParams.length + 1));
+        for (usize i = 0; i < call->inputParams.length; i++)
+        {
+            inputParams[i] = LinxcCloneExpr(state, &call->inputParams.data[i]);
+        }
+        result.data.functionCall.inputParams = collections::Array<LinxcExpression>(allocator, inputParams, call->inputParams.length);
+        if (call->templateSpecializations.length > 0)
+        {
+            LinxcTypeReference *specializations = (LinxcTypeReference*)allocator->Allocate(sizeof(LinxcTypeReference) * call->templateSpecializations.length);
+            for (usize i = 0; i < call->templateSpecializations.length; i++)
+            {
+                specializations[i] = LinxcSubstituteType(state, call->templateSpecializations.data[i]);
+            }
+            result.data.functionCall.templateSpecializations = collections::Array<LinxcTypeReference>(allocator, specializations, call->templateSpecializations.length);
+        }
+    }
+    break;
+    case LinxcExpr_OperatorCall:
+    {
+        LinxcOperator *source = expr->data.operatorCall;
+        LinxcOperator *operatorCall = (LinxcOperator*)allocator->Allocate(sizeof(LinxcOperator));
+        operatorCall->operatorType = source->operatorType;
+        operatorCall->overload = NULL;
+        operatorCall->leftExpr = LinxcCloneExpr(state, &source->leftExpr);
+        operatorCall->rightExpr = LinxcCloneExpr(state, &source->rightExpr);
+
+        bool isMemberAccess = source->operatorType == Linxc_Period || source->operatorType == Linxc_Arrow;
+        LinxcType *owner = source->leftExpr.resolvesTo.lastType;
+        if (isMemberAccess && source->rightExpr.ID == LinxcExpr_Variable && owner != NULL && owner->isDependent && owner != state->templateType)
+        {
+            //members of another dependent specialization, such as node->value for a Node<T> *node
+            LinxcVar *member = source->rightExpr.data.variable;
+            LinxcType *newOwner = operatorCall->leftExpr.resolvesTo.lastType;
+            if (member >= owner->variables.ptr && member < owner->variables.ptr + owner->variables.count)
+            {
+                operatorCall->rightExpr.data.variable = newOwner->variables.Get(member - owner->variables.ptr);
+            }
+        }
+        //operators on template parameters could not be resolved while parsing the template
+        if (source->operatorType != Linxc_ColonColon && !isMemberAccess)
+        {
+            option<LinxcTypeReference> resolvesTo = operatorCall->EvaluatePossible(state->operatorIndex);
+            if (resolvesTo.present)
+            {
+                result.resolvesTo = resolvesTo.value;
+            }
+        }
+        else result.resolvesTo = operatorCall->rightExpr.resolvesTo;
+        result.data.operatorCall = operatorCall;
+    }
+    break;
+    default:
+        break;
+    }
+    return result;
+}
+static LinxcVar LinxcCloneVar(LinxcInstantiation *state, LinxcVar *var)
+{
+    LinxcVar result = *var;
+    result.type = LinxcCloneExpr(state, &var->type);
+    if (var->defaultValue.present)
+    {
+        result.defaultValue.value = LinxcCloneExpr(state, &var->defaultValue.value);
+    }
+    return result;
+}
+//Substitutes the signature of every method of the template into instance, leaving their bodies empty
+static void LinxcCloneSignatures(LinxcInstantiation *state)
+{
+    IAllocator *allocator = state->instances->allocator;
+    LinxcType *templateType = state->templateType;
+    for (usize i = 0; i < templateType->functions.count; i++)
+    {
+        LinxcFunc *source = templateType->functions.Get(i);
+        LinxcFunc func = LinxcFunc(source->name, LinxcCloneExpr(state, &source->returnType));
+        LinxcVar *arguments = (LinxcVar*)allocator->Allocate(sizeof(LinxcVar) * (source->arguments.length + 1));
+        for (usize j = 0; j < source->arguments.length; j++)
+        {
+            arguments[j] = LinxcCloneVar(state, &source->arguments.data[j]);
+        }
+        func.arguments = collections::Array<LinxcVar>(allocator, arguments, source->arguments.length);
+        func.necessaryArguments = source->necessaryArguments;
+        func.attributes = source->attributes;
+        func.methodOf = state->instance;
+        state->instance->functions.Add(func);
+    }
+}
+static void LinxcCloneBodies(LinxcInstantiation *state)
+{
+    IAllocator *allocator = state->instances->allocator;
+    LinxcType *templateType = state->templateType;
+    for (usize i = 0; i < templateType->functions.count; i++)
+    {
+        LinxcFunc *source = templateType->functions.Get(i);
+        LinxcFunc *func = state->instance->functions.Get(i);
+        state->method = func;
+        state->thisVar = NULL;
+        for (usize j = 0; j < source->arguments.length; j++)
+        {
+            state->vars.Add(&source->arguments.data[j], &func->arguments.data[j]);
+        }
+        func->body = collections::vector<LinxcStatement>(allocator);
+        for (usize j = 0; j < source->body.count; j++)
+        {
+            LinxcStatement *sourceStmt = source->body.Get(j);
+            LinxcStatement stmt = *sourceStmt;
+            if (sourceStmt->ID == LinxcStmt_Expr)
+            {
+                stmt.data.expression = LinxcCloneExpr(state, &sourceStmt->data.expression);
+            }
+            else if (sourceStmt->ID == LinxcStmt_Return)
+            {
+                stmt.data.returnStatement = LinxcCloneExpr(state, &sourceStmt->data.returnStatement);
+            }
+            else if (sourceStmt->ID == LinxcStmt_VarDecl)
+            {
+                LinxcVar *local = (LinxcVar*)allocator->Allocate(sizeof(LinxcVar));
+                *local = LinxcCloneVar(state, sourceStmt->data.varDeclaration);
+                state->vars.Add(sourceStmt->data.varDeclaration, local);
+                stmt.data.varDeclaration = local;
+            }
+            func->body.Add(stmt);
+        }
+    }
+    state->method = NULL;
+}
+
+LinxcType *LinxcTemplateInstances::Instantiate(LinxcTypeTable *typeTable, LinxcOperatorIndex *operatorIndex, LinxcType *templateType, collections::Array<LinxcTypeReference> args)
+{
+    LinxcTypeReference key = LinxcTypeReference(templateType);
+    key.templateArgs = args;
+    u32 ID = typeTable->Intern(&key);
+    LinxcType **existing = this->byID.Get(ID);
+    if (existing != NULL)
+    {
+        return *existing;
+    }
+
+    //named after the C names of its arguments, such that vector<Game::Particle*> is vector_Game_ParticlePtr
+    string name = string(this->allocator, templateType->name.buffer);
+    bool isDependent = false;
+    LinxcTypeReference *ownedArgs = (LinxcTypeReference*)this->allocator->Allocate(sizeof(LinxcTypeReference) * args.length);
+    for (usize i = 0; i < args.length; i++)
+    {
+        ownedArgs[i] = args.data[i];
+        ownedArgs[i].templateArgs = collections::Array<LinxcTypeReference>();
+        isDependent = isDependent || args.data[i].IsDependent();
+        name.Append("_");
+        name.Append(args.data[i].lastType->GetCName(this->allocator));
+        for (u32 j = 0; j < args.data[i].pointerCount; j++)
+        {
+            name.Append("Ptr");
+        }
+    }
+
+    LinxcType newType = LinxcType(this->allocator, name, templateType->typeNamespace, NULL);
+    newType.ID = ID;
+    newType.attributes = templateType->attributes;
+    newType.templateOf = templateType;
+    newType.instanceArgs = collections::Array<LinxcTypeReference>(this->allocator, ownedArgs, args.length);
+    newType.isDependent = isDependent;
+    LinxcType *instance;
+    if (isDependent)
+    {
+        //only ever referred to from within templates, so there is no need to make it visible
+        instance = (LinxcType*)this->allocator->Allocate(sizeof(LinxcType));
+        *instance = newType;
+    }
+    else
+    {
+        instance = templateType->typeNamespace->AddType(newType);
+        this->concrete.Add(instance);
+    }
+    this->byID.Add(ID, instance);
+
+    LinxcInstantiation state;
+    state.instances = this;
+    state.typeTable = typeTable;
+    state.operatorIndex = operatorIndex;
+    state.templateType = templateType;
+    state.instance = instance;
+    state.vars = collections::hashmap<LinxcVar*, LinxcVar*, collections::PointerKeys>(&defaultAllocator);
+    state.method = NULL;
+    state.thisVar = NULL;
+    //every member is added before pointers to any of them are taken, as adding reallocates
+    for (usize i = 0; i < templateType->variables.count; i++)
+    {
+        instance->variables.Add(LinxcCloneVar(&state, templateType->variables.Get(i)));
+    }
+    LinxcCloneSignatures(&state);
+    state.vars.deinit();
+
+    if (!isDependent)
+    {
+        this->pending.Add(instance);
+    }
+    if (!this->cloningBodies)
+    {
+        //bodies are cloned last, as they may use members of specializations still being instantiated further up the stack
+        this->cloningBodies = true;
+        for (usize i = 0; i < this->pending.count; i++)
+        {
+            LinxcType *pendingInstance = this->pending.ptr[i];
+            state.templateType = pendingInstance->templateOf;
+            state.instance = pendingInstance;
+            state.vars = collections::hashmap<LinxcVar*, LinxcVar*, collections::PointerKeys>(&defaultAllocator);
+            LinxcCloneBodies(&state);
+            state.vars.deinit();
+        }
+        this->pending.Clear();
+        this->cloningBodies = false;
+    }
+    return instance;
+}
+
+LinxcInstanceUses::LinxcInstanceUses(IAllocator *allocator)
+{
+    this->instances = collections::vector<LinxcType*>(allocator);
+    this->forwards = collections::vector<LinxcType*>(allocator);
+    this->visiting = collections::vector<LinxcType*>(allocator);
+}
+void LinxcInstanceUses::deinit()
+{
+    this->instances.deinit();
+    this->forwards.deinit();
+    this->visiting.deinit();
+}
+static bool LinxcContainsType(collections::vector<LinxcType*> *types, LinxcType *type)
+{
+    for (usize i = 0; i < types->count; i++)
+    {
+        if (types->ptr[i] == type)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+static void LinxcAddTypeOf(LinxcInstanceUses *uses, LinxcExpression *typeExpr)
+{
+    option<LinxcTypeReference> typeRef = typeExpr->AsTypeReference();
+    if (typeRef.present)
+    {
+        uses->Add(typeRef.value.lastType);
+    }
+}
+void LinxcInstanceUses::Add(LinxcType *type)
+{
+    if (type == NULL || type->templateOf == NULL || type->isDependent || !type->isReachable || LinxcContainsType(&this->instances, type))
+    {
+        return;
+    }
+    if (LinxcContainsType(&this->visiting, type))
+    {
+        if (!LinxcContainsType(&this->forwards, type))
+        {
+            this->forwards.Add(type);
+        }
+        return;
+    }
+    this->visiting.Add(type);
+    for (usize i = 0; i < type->variables.count; i++)
+    {
+        LinxcAddTypeOf(this, &type->variables.Get(i)->type);
+    }
+    for (usize i = 0; i < type->functions.count; i++)
+    {
+        LinxcFunc *func = type->functions.Get(i);
+        LinxcAddTypeOf(this, &func->returnType);
+        for (usize j = 0; j < func->arguments.length; j++)
+        {
+            LinxcAddTypeOf(this, &func->arguments.data[j].type);
+        }
+    }
+    this->visiting.RemoveAt_Swap(this->visiting.count - 1);
+    this->instances.Add(type);
+}
+static void LinxcCollectExpr(LinxcInstanceUses *uses, LinxcExpression *expr)
+{
+    uses->Add(expr->resolvesTo.lastType);
+    switch (expr->ID)
+    {
+    case LinxcExpr_TypeRef:
+        uses->Add(expr->data.typeRef.lastType);
+        break;
+    case LinxcExpr_Sizeof:
+        uses->Add(expr->data.sizeofCall.lastType);
+        break;
+    case LinxcExpr_Modified:
+        LinxcCollectExpr(uses, &expr->data.modifiedExpression->expression);
+        break;
+    case LinxcExpr_TypeCast:
+        LinxcCollectExpr(uses, &expr->data.typeCast->castToType);
+        LinxcCollectExpr(uses, &expr->data.typeCast->expressionToCast);
+        break;
+    case LinxcExpr_Indexer:
+        LinxcCollectExpr(uses, expr->data.indexerCall);
+        break;
+    case LinxcExpr_FuncCall:
+        //calling a method needs its prototype, which comes with its type
+        uses->Add(expr->data.functionCall.func->methodOf);
+        for (usize i = 0; i < expr->data.functionCall.inputParams.length; i++)
+        {
+            LinxcCollectExpr(uses, &expr->data.functionCall.inputParams.data[i]);
+        }
+        break;
+    case LinxcExpr_OperatorCall:
+        LinxcCollectExpr(uses, &expr->data.operatorCall->leftExpr);
+        LinxcCollectExpr(uses, &expr->data.operatorCall->rightExpr);
+        break;
+    default:
+        break;
+    }
+}
+static void LinxcCollectVar(LinxcInstanceUses *uses, LinxcVar *var)
+{
+    LinxcCollectExpr(uses, &var->type);
+    if (var->defaultValue.present)
+    {
+        LinxcCollectExpr(uses, &var->defaultValue.value);
+    }
+}
+static void LinxcCollectFunc(LinxcInstanceUses *uses, LinxcFunc *func)
+{
+    if (!func->isReachable)
+    {
+        return;
+    }
+    LinxcCollectExpr(uses, &func->returnType);
+    for (usize i = 0; i < func->arguments.length; i++)
+    {
+        LinxcCollectVar(uses, &func->arguments.data[i]);
+    }
+    for (usize i = 0; i < func->body.count; i++)
+    {
+        uses->Collect(func->body.Get(i));
+    }
+}
+void LinxcInstanceUses::Collect(LinxcStatement *stmt)
+{
+    switch (stmt->ID)
+    {
+    case LinxcStmt_Expr:
+        LinxcCollectExpr(this, &stmt->data.expression);
+        break;
+    case LinxcStmt_Return:
+        LinxcCollectExpr(this, &stmt->data.returnStatement);
+        break;
+    case LinxcStmt_VarDecl:
+        LinxcCollectVar(this, stmt->data.varDeclaration);
+        break;
+    case LinxcStmt_FuncDecl:
+        LinxcCollectFunc(this, stmt->data.funcDeclaration);
+        break;
+    case LinxcStmt_TypeDecl:
+    {
+        LinxcType *type = stmt->data.typeDeclaration;
+        if (type->isDependent || !type->isReachable)
+        {
+            break;
+        }
+        for (usize i = 0; i < type->variables.count; i++)
+        {
+            LinxcCollectVar(this, type->variables.Get(i));
+        }
+        for (usize i = 0; i < type->functions.count; i++)
+        {
+            LinxcCollectFunc(this, type->functions.Get(i));
+        }
+        for (usize i = 0; i < type->operatorOverloads.entries.count; i++)
+        {
+            LinxcCollectFunc(this, &type->operatorOverloads.entries.ptr[i].func->function);
+        }
+    }
+    break;
+    case LinxcStmt_Namespace:
+        for (usize i = 0; i < stmt->data.namespaceScope.body.count; i++)
+        {
+            this->Collect(stmt->data.namespaceScope.body.Get(i));
+        }
+        break;
+    default:
+        break;
+    }
+}
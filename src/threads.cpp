@@ -0,0 +1,75 @@
+#include <threads.hpp>
+
+#if POSIX
+#include <unistd.h>
+#endif
+
+#if WINDOWS
+static DWORD WINAPI LinxcThreadEntry(LPVOID parameter)
+{
+    LinxcThread *thread = (LinxcThread*)parameter;
+    thread->func(thread->data);
+    return 0;
+}
+#endif
+#if POSIX
+static void *LinxcThreadEntry(void *parameter)
+{
+    LinxcThread *thread = (LinxcThread*)parameter;
+    thread->func(thread->data);
+    return NULL;
+}
+#endif
+
+LinxcThread::LinxcThread()
+{
+    this->func = NULL;
+    this->data = NULL;
+    this->started = false;
+}
+bool LinxcThread::Start(LinxcThreadFunc func, void *data)
+{
+    this->func = func;
+    this->data = data;
+    #if WINDOWS
+    this->handle = CreateThread(NULL, 0, &LinxcThreadEntry, this, 0, NULL);
+    this->started = this->handle != NULL;
+    #endif
+    #if POSIX
+    this->started = pthread_create(&this->handle, NULL, &LinxcThreadEntry, this) == 0;
+    #endif
+    if (!this->started)
+    {
+        func(data);
+    }
+    return this->started;
+}
+void LinxcThread::Join()
+{
+    if (!this->started)
+    {
+        return;
+    }
+    #if WINDOWS
+    WaitForSingleObject(this->handle, INFINITE);
+    CloseHandle(this->handle);
+    #endif
+    #if POSIX
+    pthread_join(this->handle, NULL);
+    #endif
+    this->started = false;
+}
+
+u32 LinxcHardwareThreadCount()
+{
+    #if WINDOWS
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (u32)info.dwNumberOfProcessors : 1;
+    #elif POSIX
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (u32)count : 1;
+    #else
+    return 1;
+    #endif
+}
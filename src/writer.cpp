@@ -0,0 +1,71 @@
+#include <writer.hpp>
+#include <io.hpp>
+
+LinxcWriter::LinxcWriter()
+{
+    this->allocator = &defaultAllocator;
+    this->buffer = NULL;
+    this->length = 0;
+    this->capacity = 0;
+}
+LinxcWriter::LinxcWriter(IAllocator *allocator)
+{
+    this->allocator = allocator;
+    this->buffer = NULL;
+    this->length = 0;
+    this->capacity = 0;
+}
+LinxcWriter::LinxcWriter(IAllocator *allocator, usize minCapacity)
+{
+    this->allocator = allocator;
+    this->buffer = NULL;
+    this->length = 0;
+    this->capacity = 0;
+    this->EnsureCapacity(minCapacity);
+}
+void LinxcWriter::deinit()
+{
+    if (this->buffer != NULL)
+    {
+        this->allocator->Free((void**)&this->buffer);
+    }
+    this->length = 0;
+    this->capacity = 0;
+}
+void LinxcWriter::Clear()
+{
+    this->length = 0;
+}
+void LinxcWriter::EnsureCapacity(usize minCapacity)
+{
+    if (minCapacity <= this->capacity)
+    {
+        return;
+    }
+    usize newCapacity = this->capacity < 256 ? 256 : this->capacity;
+    while (newCapacity < minCapacity)
+    {
+        newCapacity *= 2;
+    }
+    char *newBuffer = (char*)this->allocator->Allocate(newCapacity);
+    if (this->buffer != NULL)
+    {
+        memcpy(newBuffer, this->buffer, this->length);
+        this->allocator->Free((void**)&this->buffer);
+    }
+    this->buffer = newBuffer;
+    this->capacity = newCapacity;
+}
+void LinxcWriter::Append(const char *text, usize textLength)
+{
+    if (this->length + textLength > this->capacity)
+    {
+        this->EnsureCapacity(this->length + textLength);
+    }
+    memcpy(this->buffer + this->length, text, textLength);
+    this->length += textLength;
+}
+bool LinxcWriter::WriteToFile(const char *path)
+{
+    return io::WriteFileIfChanged(path, this->buffer, this->length);
+}